@@ -0,0 +1,113 @@
+/**
+ * @file bench.h
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Timing helpers for the host benchmarks.
+ *
+ * The benchmarks are plain host programs, each built from the repository
+ * root with every source of the library:
+ * @code
+ * g++ -std=gnu++11 -O2 -Isrc bench/<name>.cpp src/[a-z]*.cpp -o <name>
+ * @endcode
+ * Add @c -DCST_PARALLEL @c -pthread for the threaded ones.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef __LIB_CUSTOM_TYPE_BENCH_H__
+#define __LIB_CUSTOM_TYPE_BENCH_H__
+
+#include <chrono>
+#include <stddef.h>
+#include <stdio.h>
+#include <math.h>
+#include "artypes.h"
+
+namespace bench {
+/**
+ * @brief Keeps a result alive so the timed code is not optimised out.
+ */
+static volatile float sink;
+
+/**
+ * @brief Best wall time of a few runs of @p f.
+ *
+ * @tparam F Functor with no argument.
+ * @param f Code to time.
+ * @param runs Number of runs.
+ * @return Seconds of the fastest run.
+ */
+template <class F>
+double best(const F& f, size_t runs = 5) {
+    double t { 1e30 };
+
+    for (size_t r {}; r < runs; r++) {
+        const std::chrono::steady_clock::time_point start {
+            std::chrono::steady_clock::now()
+        };
+        f();
+        const double s {
+            std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start)
+                .count()
+        };
+        t = s < t ? s : t;
+    }
+
+    return t;
+}
+
+/**
+ * @brief Print one result line.
+ *
+ * @param name Case name.
+ * @param seconds Wall time.
+ * @param items Items processed in @p seconds.
+ */
+inline void report(const char* name, double seconds, size_t items) {
+    printf(
+        "%-32s %10.2f ns/item %10.2f Mitems/s\n",
+        name,
+        seconds * 1e9 / static_cast<double>(items),
+        static_cast<double>(items) / seconds * 1e-6);
+}
+
+/**
+ * @brief Deterministic pseudo-random value in [-1, 1) (LCG), so every run
+ * replays the same data.
+ *
+ * @param state Generator state.
+ * @return float
+ */
+inline float noise(uint32_t& state) {
+    state = state * 1664525u + 1013904223u;
+
+    return static_cast<float>(state >> 8) * (2.0f / 16777216.0f) - 1.0f;
+}
+
+/**
+ * @brief Fill a VectorArray with noise of amplitude @p scale around
+ * @p offset.
+ *
+ * @param a Array.
+ * @param offset Mean.
+ * @param scale Amplitude.
+ * @param state Generator state.
+ */
+inline void fill(
+    VectorArray& a,
+    const Vector& offset,
+    float scale,
+    uint32_t& state) {
+    for (size_t i {}; i < a.length; i++) {
+        a.x[i] = offset.x + scale * noise(state);
+        a.y[i] = offset.y + scale * noise(state);
+        a.z[i] = offset.z + scale * noise(state);
+    }
+}
+}  // namespace bench
+
+#endif /* __LIB_CUSTOM_TYPE_BENCH_H__ */
@@ -0,0 +1,102 @@
+/**
+ * @file complementary.cpp
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief ComplementaryFilter update cost against an Euler-angle filter
+ * rebuilt with Quaternion::fromAngles every sample.
+ *
+ * The reference is the usual hand-written filter: integrate Euler angles,
+ * take roll/pitch from the accelerometer and a tilt-compensated heading
+ * from the magnetometer with @c atan2, blend the angles, then build the
+ * quaternion (six more trig calls).
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "bench.h"
+
+namespace {
+const size_t N { 1000000 };
+const float DT { 1e-3f };
+
+float gx[N], gy[N], gz[N];
+float ax[N], ay[N], az[N];
+float mx[N], my[N], mz[N];
+
+/**
+ * @brief Euler-angle complementary filter.
+ */
+struct EulerFilter {
+    float roll;
+    float pitch;
+    float yaw;
+
+    Quaternion update(
+        const Vector& gyro,
+        const Vector& accel,
+        const Vector& mag,
+        float dt) {
+        const float k { 0.5f / (0.5f + dt) };
+
+        const float accRoll { atan2f(accel.y, accel.z) };
+        const float accPitch {
+            atan2f(-accel.x, sqrtf(accel.y * accel.y + accel.z * accel.z))
+        };
+        roll = k * (roll + gyro.x * dt) + (1.0f - k) * accRoll;
+        pitch = k * (pitch + gyro.y * dt) + (1.0f - k) * accPitch;
+
+        const float sr { sinf(roll) };
+        const float cr { cosf(roll) };
+        const float sp { sinf(pitch) };
+        const float cp { cosf(pitch) };
+        const float hx { mag.x * cp + mag.y * sr * sp + mag.z * cr * sp };
+        const float hy { mag.y * cr - mag.z * sr };
+        yaw = k * (yaw + gyro.z * dt) + (1.0f - k) * atan2f(-hy, hx);
+
+        return Quaternion::fromAngles(roll, pitch, yaw);
+    }
+};
+}  // namespace
+
+int main() {
+    uint32_t seed { 11 };
+    VectorArray gyro { gx, gy, gz, N };
+    VectorArray accel { ax, ay, az, N };
+    VectorArray mag { mx, my, mz, N };
+    bench::fill(gyro, Vector { 0.01f, -0.02f, 0.005f }, 0.05f, seed);
+    bench::fill(accel, Vector { 0.0f, 0.0f, 9.81f }, 0.2f, seed);
+    bench::fill(mag, Vector { 0.2f, 0.0f, 0.4f }, 0.01f, seed);
+
+    const double tTilt { bench::best([&]() {
+        ComplementaryFilter f {};
+        for (size_t i {}; i < N; i++) {
+            f.update(gyro.get(i), accel.get(i), DT);
+        }
+        bench::sink = f.orientation().w;
+    }) };
+    bench::report("ComplementaryFilter, gyro+accel", tTilt, N);
+
+    const double tFull { bench::best([&]() {
+        ComplementaryFilter f {};
+        for (size_t i {}; i < N; i++) {
+            f.update(gyro.get(i), accel.get(i), mag.get(i), DT);
+        }
+        bench::sink = f.orientation().w;
+    }) };
+    bench::report("ComplementaryFilter, +mag", tFull, N);
+
+    const double tEuler { bench::best([&]() {
+        EulerFilter f {};
+        Quaternion q {};
+        for (size_t i {}; i < N; i++) {
+            q = f.update(gyro.get(i), accel.get(i), mag.get(i), DT);
+        }
+        bench::sink = q.w;
+    }) };
+    bench::report("Euler angles + fromAngles, +mag", tEuler, N);
+
+    return 0;
+}
@@ -0,0 +1,254 @@
+/**
+ * @file eskf.cpp
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief AttitudeESKF against the same filter written with general dense
+ * matrices.
+ *
+ * The reference keeps the 6x6 covariance as one dense matrix and uses
+ * runtime-sized products and a Gauss-Jordan inverse, the way a generic
+ * matrix library evaluates @f$FPF^T+Q@f$ and the Kalman gain. Both filters
+ * run the same gyro/accel log; the bench prints the cost of each step and
+ * the attitude difference at the end.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "bench.h"
+
+namespace {
+const size_t N { 200000 };
+const size_t DIM { 6 };
+const float DT { 1e-3f };
+const float GYRO_DENSITY { 1e-3f };
+const float BIAS_DENSITY { 1e-5f };
+const float ACCEL_STD { 0.05f };
+
+/**
+ * @brief @p out = @p a (@p n x @p m) times @p b (@p m x @p p), row-major.
+ */
+void multiply(
+    const float* a,
+    const float* b,
+    float* out,
+    size_t n,
+    size_t m,
+    size_t p) {
+    for (size_t i {}; i < n; i++) {
+        for (size_t j {}; j < p; j++) {
+            float s {};
+            for (size_t k {}; k < m; k++) {
+                s += a[i * m + k] * b[k * p + j];
+            }
+            out[i * p + j] = s;
+        }
+    }
+}
+
+/**
+ * @brief @p out = transpose of @p a (@p n x @p m).
+ */
+void transpose(const float* a, float* out, size_t n, size_t m) {
+    for (size_t i {}; i < n; i++) {
+        for (size_t j {}; j < m; j++) {
+            out[j * n + i] = a[i * m + j];
+        }
+    }
+}
+
+/**
+ * @brief Gauss-Jordan inverse of @p a (@p n x @p n), partial pivoting.
+ */
+void inverse(const float* a, float* out, size_t n) {
+    float w[DIM * 2 * DIM];
+    for (size_t i {}; i < n; i++) {
+        for (size_t j {}; j < n; j++) {
+            w[i * 2 * n + j] = a[i * n + j];
+            w[i * 2 * n + n + j] = i == j ? 1.0f : 0.0f;
+        }
+    }
+    for (size_t c {}; c < n; c++) {
+        size_t p { c };
+        for (size_t r { c + 1 }; r < n; r++) {
+            p = fabsf(w[r * 2 * n + c]) > fabsf(w[p * 2 * n + c]) ? r : p;
+        }
+        for (size_t j {}; j < 2 * n; j++) {
+            const float t { w[c * 2 * n + j] };
+            w[c * 2 * n + j] = w[p * 2 * n + j];
+            w[p * 2 * n + j] = t;
+        }
+        const float d { 1.0f / w[c * 2 * n + c] };
+        for (size_t j {}; j < 2 * n; j++) {
+            w[c * 2 * n + j] *= d;
+        }
+        for (size_t r {}; r < n; r++) {
+            const float f { w[r * 2 * n + c] };
+            if (r != c) {
+                for (size_t j {}; j < 2 * n; j++) {
+                    w[r * 2 * n + j] -= f * w[c * 2 * n + j];
+                }
+            }
+        }
+    }
+    for (size_t i {}; i < n; i++) {
+        for (size_t j {}; j < n; j++) {
+            out[i * n + j] = w[i * 2 * n + n + j];
+        }
+    }
+}
+
+/**
+ * @brief Dense 6-state attitude/bias error-state filter.
+ */
+struct DenseEskf {
+    Quaternion attitude;
+    Vector gyroBias;
+    float p[DIM * DIM];
+
+    DenseEskf() : attitude {}, gyroBias {}, p {} {
+        for (size_t i {}; i < DIM; i++) {
+            p[i * DIM + i] = i < 3 ? cst::sqr(0.1f) : cst::sqr(0.01f);
+        }
+    }
+
+    void predict(const Vector& gyro, float dt) {
+        const Quaternion step {
+            Quaternion::fromRotationVector((gyro - gyroBias) * dt)
+        };
+        const Matrix3x3 a { step.conjugate().toRotationMatrix() };
+
+        float f[DIM * DIM] {};
+        for (size_t r {}; r < 3; r++) {
+            for (size_t c {}; c < 3; c++) {
+                f[r * DIM + c] = a.coeff(r, c);
+            }
+            f[r * DIM + r + 3] = -dt;
+            f[(r + 3) * DIM + r + 3] = 1.0f;
+        }
+
+        float fp[DIM * DIM];
+        float ft[DIM * DIM];
+        multiply(f, p, fp, DIM, DIM, DIM);
+        transpose(f, ft, DIM, DIM);
+        multiply(fp, ft, p, DIM, DIM, DIM);
+        for (size_t i {}; i < DIM; i++) {
+            p[i * DIM + i] += (i < 3 ? cst::sqr(GYRO_DENSITY)
+                                     : cst::sqr(BIAS_DENSITY))
+                * dt;
+        }
+
+        attitude *= step;
+        attitude.normalize();
+    }
+
+    void correct(const Vector& measured, const Vector& reference) {
+        const Vector z { measured.normalised() };
+        const Vector h { attitude.conjugate().rotate(reference.normalised()) };
+        const Matrix3x3 hs { Matrix3x3::skew(h) };
+
+        float hm[3 * DIM] {};
+        for (size_t r {}; r < 3; r++) {
+            for (size_t c {}; c < 3; c++) {
+                hm[r * DIM + c] = hs.coeff(r, c);
+            }
+        }
+
+        float ht[DIM * 3];
+        float pht[DIM * 3];
+        float s[3 * 3];
+        float sInv[3 * 3];
+        float k[DIM * 3];
+        float kt[3 * DIM];
+        float khp[DIM * DIM];
+        transpose(hm, ht, 3, DIM);
+        multiply(p, ht, pht, DIM, DIM, 3);
+        multiply(hm, pht, s, 3, DIM, 3);
+        for (size_t i {}; i < 3; i++) {
+            s[i * 3 + i] += cst::sqr(ACCEL_STD);
+        }
+        inverse(s, sInv, 3);
+        multiply(pht, sInv, k, DIM, 3, 3);
+
+        // P -= (P H^T) K^T, then symmetrise
+        transpose(k, kt, DIM, 3);
+        multiply(pht, kt, khp, DIM, 3, DIM);
+        for (size_t i {}; i < DIM * DIM; i++) {
+            p[i] -= khp[i];
+        }
+        for (size_t i {}; i < DIM; i++) {
+            for (size_t j { i + 1 }; j < DIM; j++) {
+                const float m { 0.5f * (p[i * DIM + j] + p[j * DIM + i]) };
+                p[i * DIM + j] = m;
+                p[j * DIM + i] = m;
+            }
+        }
+
+        const float y[3] { z.x - h.x, z.y - h.y, z.z - h.z };
+        float dx[DIM];
+        multiply(k, y, dx, DIM, 3, 1);
+
+        attitude *= Quaternion::fromRotationVector(
+            Vector { dx[0], dx[1], dx[2] });
+        attitude.normalize();
+        gyroBias += Vector { dx[3], dx[4], dx[5] };
+    }
+};
+
+float gx[N], gy[N], gz[N];
+float ax[N], ay[N], az[N];
+}  // namespace
+
+int main() {
+    uint32_t seed { 7 };
+    VectorArray gyro { gx, gy, gz, N };
+    VectorArray accel { ax, ay, az, N };
+    bench::fill(gyro, Vector { 0.01f, -0.02f, 0.005f }, 0.05f, seed);
+    bench::fill(accel, Vector { 0.0f, 0.0f, -9.81f }, 0.2f, seed);
+    const Vector up { 0.0f, 0.0f, -1.0f };
+
+    AttitudeESKF blocks { GYRO_DENSITY, BIAS_DENSITY };
+    DenseEskf dense {};
+
+    const double tBlocks { bench::best([&]() {
+        blocks = AttitudeESKF { GYRO_DENSITY, BIAS_DENSITY };
+        for (size_t i {}; i < N; i++) {
+            blocks.predict(gyro.get(i), DT);
+        }
+    }) };
+    const double tDense { bench::best([&]() {
+        dense = DenseEskf {};
+        for (size_t i {}; i < N; i++) {
+            dense.predict(gyro.get(i), DT);
+        }
+    }) };
+    bench::report("predict, Matrix3x3 blocks", tBlocks, N);
+    bench::report("predict, dense 6x6", tDense, N);
+
+    const double tBlocksFull { bench::best([&]() {
+        blocks = AttitudeESKF { GYRO_DENSITY, BIAS_DENSITY };
+        for (size_t i {}; i < N; i++) {
+            blocks.predict(gyro.get(i), DT);
+            blocks.correct(accel.get(i), up, ACCEL_STD);
+        }
+    }) };
+    const double tDenseFull { bench::best([&]() {
+        dense = DenseEskf {};
+        for (size_t i {}; i < N; i++) {
+            dense.predict(gyro.get(i), DT);
+            dense.correct(accel.get(i), up);
+        }
+    }) };
+    bench::report("predict+correct, blocks", tBlocksFull, N);
+    bench::report("predict+correct, dense 6x6", tDenseFull, N);
+
+    const float d { fabsf(blocks.orientation().dot(dense.attitude)) };
+    printf(
+        "attitude difference after %zu samples: %g rad\n",
+        N,
+        2.0f * acosf(d < 1.0f ? d : 1.0f));
+
+    return 0;
+}
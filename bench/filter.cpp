@@ -0,0 +1,162 @@
+/**
+ * @file filter.cpp
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief FirFilter and BiquadCascade throughput for typical sizes.
+ *
+ * Each filter runs per sample (#update) and in batch (#process) over a
+ * 3-axis stream, against the reference written with Vector operators
+ * (@c acc += in * h per tap, a ring of Vectors). Throughput is in 3-axis
+ * samples per second.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "bench.h"
+
+namespace {
+const size_t N { 1 << 18 };
+const float RATE { 1000.0f };
+
+float ix[N], iy[N], iz[N];
+float ox[N], oy[N], oz[N];
+
+/**
+ * @brief FIR over Vectors, one ring, scalar operators.
+ */
+struct VectorFir {
+    float taps[FIR_MAX_TAPS];
+    Vector ring[FIR_MAX_TAPS];
+    size_t length;
+    size_t pos;
+
+    Vector update(const Vector& in) {
+        pos = pos == 0 ? length - 1 : pos - 1;
+        ring[pos] = in;
+
+        Vector acc {};
+        for (size_t k {}; k < length; k++) {
+            const size_t i { pos + k < length ? pos + k : pos + k - length };
+            acc += ring[i] * taps[k];
+        }
+
+        return acc;
+    }
+};
+
+/**
+ * @brief Time one FIR size.
+ *
+ * @param in Input.
+ * @param out Output.
+ * @param taps Number of taps.
+ */
+void fir(const VectorArray& in, VectorArray& out, size_t taps) {
+    FirFilter f {};
+    f.lowPass(50.0f, RATE, taps);
+
+    VectorFir ref;
+    ref.length = taps;
+    ref.pos = 0;
+    for (size_t k {}; k < taps; k++) {
+        ref.taps[k] = 1.0f / static_cast<float>(taps);
+        ref.ring[k] = Vector {};
+    }
+
+    const double tUpdate { bench::best([&]() {
+        f.reset();
+        for (size_t i {}; i < in.length; i++) {
+            out.set(i, f.update(in.get(i)));
+        }
+    }) };
+    const double tBatch { bench::best([&]() {
+        f.reset();
+        f.process(in, out);
+    }) };
+    const double tRef { bench::best([&]() {
+        for (size_t i {}; i < in.length; i++) {
+            out.set(i, ref.update(in.get(i)));
+        }
+    }) };
+
+    char name[48];
+    snprintf(name, sizeof(name), "FIR %zu taps, update", taps);
+    bench::report(name, tUpdate, in.length);
+    snprintf(name, sizeof(name), "FIR %zu taps, process", taps);
+    bench::report(name, tBatch, in.length);
+    snprintf(name, sizeof(name), "FIR %zu taps, Vector operators", taps);
+    bench::report(name, tRef, in.length);
+}
+
+/**
+ * @brief Time one cascade size.
+ *
+ * @param in Input.
+ * @param out Output.
+ * @param sections Number of sections.
+ */
+void iir(const VectorArray& in, VectorArray& out, size_t sections) {
+    BiquadCascade c {};
+    for (size_t s {}; s < sections; s++) {
+        c.addSection(Biquad::lowPass(50.0f, RATE));
+    }
+
+    const Biquad b { Biquad::lowPass(50.0f, RATE) };
+    Vector z1[BIQUAD_MAX_SECTIONS];
+    Vector z2[BIQUAD_MAX_SECTIONS];
+
+    const double tUpdate { bench::best([&]() {
+        c.reset();
+        for (size_t i {}; i < in.length; i++) {
+            out.set(i, c.update(in.get(i)));
+        }
+    }) };
+    const double tBatch { bench::best([&]() {
+        c.reset();
+        c.process(in, out);
+    }) };
+    const double tRef { bench::best([&]() {
+        for (size_t s {}; s < sections; s++) {
+            z1[s] = Vector {};
+            z2[s] = Vector {};
+        }
+        for (size_t i {}; i < in.length; i++) {
+            Vector v { in.get(i) };
+            // transposed direct form II
+            for (size_t s {}; s < sections; s++) {
+                const Vector y { v * b.b0 + z1[s] };
+                z1[s] = v * b.b1 - y * b.a1 + z2[s];
+                z2[s] = v * b.b2 - y * b.a2;
+                v = y;
+            }
+            out.set(i, v);
+        }
+    }) };
+
+    char name[48];
+    snprintf(name, sizeof(name), "biquad x%zu, update", sections);
+    bench::report(name, tUpdate, in.length);
+    snprintf(name, sizeof(name), "biquad x%zu, process", sections);
+    bench::report(name, tBatch, in.length);
+    snprintf(name, sizeof(name), "biquad x%zu, Vector operators", sections);
+    bench::report(name, tRef, in.length);
+}
+}  // namespace
+
+int main() {
+    uint32_t seed { 5 };
+    VectorArray in { ix, iy, iz, N };
+    VectorArray out { ox, oy, oz, N };
+    bench::fill(in, Vector { 0.0f, 0.0f, 9.81f }, 1.0f, seed);
+
+    fir(in, out, 8);
+    fir(in, out, 31);
+    fir(in, out, 63);
+    iir(in, out, 1);
+    iir(in, out, 4);
+
+    return 0;
+}
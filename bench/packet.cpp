@@ -0,0 +1,167 @@
+/**
+ * @file packet.cpp
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief PacketDecoder throughput on interleaved device streams.
+ *
+ * Each device sends one Vector packet per sample. Its stream arrives in
+ * reads of 1 to 64 bytes, and the reads of all devices are interleaved
+ * as an event loop sees them. One PacketDecoder per device feeds a
+ * handler that accumulates the samples (a stand-in for the fusion step).
+ * The bench prints packets per second and how many 1 kHz devices one
+ * core decodes, on a clean link and with 1 byte in 1000 corrupted.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "bench.h"
+
+namespace {
+const size_t DEVICES { 256 };
+const size_t FRAMES { 1000 };
+const size_t MAX_READ { 64 };
+const float RATE { 1000.0f };
+// Vector frame: 16-byte payload instead of 20
+const size_t FRAME { PACKET_MAX_FRAME - 4 };
+const size_t BYTES { DEVICES * FRAMES * FRAME };
+
+/**
+ * @brief One read of a device, in arrival order.
+ */
+struct Read {
+    uint16_t device;
+    uint16_t length;
+    uint32_t offset;
+};
+
+uint8_t stream[BYTES];
+Read reads[BYTES];
+size_t readCount;
+PacketDecoder decoders[DEVICES];
+
+/**
+ * @brief Handler: accumulate the samples of a device.
+ */
+void fuse(void* context, const Packet& packet) {
+    Vector& acc { *static_cast<Vector*>(context) };
+    acc += packet.vector;
+}
+
+/**
+ * @brief Build the interleaved stream.
+ *
+ * @param corrupt Corrupt about one byte in @p corrupt, 0 for none.
+ * @param seed Noise state.
+ * @return Number of bytes.
+ */
+size_t build(uint32_t corrupt, uint32_t& seed) {
+    static uint8_t frames[DEVICES][FRAMES * FRAME];
+    size_t lengths[DEVICES];
+    size_t sent[DEVICES];
+
+    for (size_t d {}; d < DEVICES; d++) {
+        size_t n {};
+        for (size_t f {}; f < FRAMES; f++) {
+            const Vector v { bench::noise(seed), bench::noise(seed), 9.81f };
+            const Packet p {
+                static_cast<uint8_t>(d), static_cast<uint32_t>(f * 1000), v
+            };
+            n += p.encode(frames[d] + n);
+        }
+        lengths[d] = n;
+        sent[d] = 0;
+    }
+
+    size_t total {};
+    readCount = 0;
+    for (bool more { true }; more;) {
+        more = false;
+        for (size_t d {}; d < DEVICES; d++) {
+            const size_t left { lengths[d] - sent[d] };
+            if (left == 0) {
+                continue;
+            }
+            const float u { 0.5f + 0.5f * bench::noise(seed) };
+            size_t len { 1 + static_cast<size_t>(u * (MAX_READ - 1)) };
+            len = len < left ? len : left;
+
+            Read& r { reads[readCount++] };
+            r.device = static_cast<uint16_t>(d);
+            r.length = static_cast<uint16_t>(len);
+            r.offset = static_cast<uint32_t>(total);
+            for (size_t i {}; i < len; i++) {
+                stream[total++] = frames[d][sent[d] + i];
+            }
+            sent[d] += len;
+            more = true;
+        }
+    }
+
+    if (corrupt > 0) {
+        for (size_t i {}; i < total; i++) {
+            seed = seed * 1664525u + 1013904223u;
+            if (seed % corrupt == 0) {
+                stream[i] ^= 0x5A;
+            }
+        }
+    }
+
+    return total;
+}
+
+/**
+ * @brief Time decoding of the interleaved stream.
+ *
+ * @param name Case name.
+ * @param bytes Number of bytes.
+ */
+void run(const char* name, size_t bytes) {
+    Vector acc[DEVICES];
+    size_t packets {};
+
+    const double t { bench::best([&]() {
+        packets = 0;
+        for (size_t d {}; d < DEVICES; d++) {
+            decoders[d].reset();
+            acc[d] = Vector {};
+        }
+        for (size_t k {}; k < readCount; k++) {
+            const Read& r { reads[k] };
+            packets += decoders[r.device].feed(
+                stream + r.offset, r.length, fuse, &acc[r.device]);
+        }
+        bench::sink = acc[0].x;
+    }) };
+
+    size_t errors {};
+    for (size_t d {}; d < DEVICES; d++) {
+        errors += decoders[d].errors();
+    }
+
+    const double perSecond { static_cast<double>(packets) / t };
+    printf(
+        "%s: %zu bytes, %zu packets, %zu dropped frames\n",
+        name,
+        bytes,
+        packets,
+        errors);
+    bench::report("  decode + handler, per packet", t, packets);
+    printf(
+        "  %.2f ns/byte, %.0f devices/core at %.0f Hz\n",
+        t * 1e9 / static_cast<double>(bytes),
+        perSecond / RATE,
+        RATE);
+}
+}  // namespace
+
+int main() {
+    uint32_t seed { 23 };
+
+    run("clean link", build(0, seed));
+    run("1/1000 bytes corrupted", build(1000, seed));
+
+    return 0;
+}
@@ -0,0 +1,122 @@
+/**
+ * @file parallel.cpp
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief ParallelPool scaling over the batch kernels, 1 to N workers.
+ *
+ * Each kernel runs on 2M samples (about 100 MB of streams, well past the
+ * last-level cache) through ParallelPool::forEach, once per pool size, and
+ * the bench prints the throughput and the speedup over one worker. N is
+ * the hardware concurrency, or the first argument. The stateful filters
+ * (FirFilter, BiquadCascade) are left out: a chunk needs the previous
+ * samples to warm up, so they do not split this way.
+ *
+ * Build with -DCST_PARALLEL -pthread, without it every pool has one worker.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include <stdlib.h>
+#include "bench.h"
+
+namespace {
+const size_t N { 1 << 21 };
+
+float qw[N], qx[N], qy[N], qz[N];
+float sw[N], sx[N], sy[N], sz[N];
+float tw[N], tx[N], ty[N], tz[N];
+float ax[N], ay[N], az[N];
+float ox[N], oy[N], oz[N];
+float headings[N];
+RawVector3i16 raw[N];
+
+QuaternionArray qs { qw, qx, qy, qz, N };
+QuaternionArray swings { sw, sx, sy, sz, N };
+QuaternionArray twists { tw, tx, ty, tz, N };
+VectorArray accels { ax, ay, az, N };
+VectorArray out { ox, oy, oz, N };
+
+/**
+ * @brief Kernels under test, each run over all samples by a pool.
+ */
+void linear(ParallelPool& pool) {
+    pool.forEach(accels, [&](const VectorArray& chunk, size_t offset) {
+        VectorArray o { out.slice(offset, chunk.length) };
+        GravityRemoval::linear(qs.slice(offset, chunk.length), chunk, o);
+    });
+}
+
+void heading(ParallelPool& pool) {
+    pool.forEach(accels, [&](const VectorArray& chunk, size_t offset) {
+        GravityRemoval::heading(
+            qs.slice(offset, chunk.length), chunk, headings + offset);
+    });
+}
+
+void swingTwist(ParallelPool& pool) {
+    const Vector axis { 0.0f, 0.0f, 1.0f };
+    pool.forEach(qs, [&](const QuaternionArray& chunk, size_t offset) {
+        QuaternionArray s { swings.slice(offset, chunk.length) };
+        QuaternionArray t { twists.slice(offset, chunk.length) };
+        Quaternion::swingTwist(chunk, axis, s, t);
+    });
+}
+
+void convert(ParallelPool& pool) {
+    const RawConverter c { 1.0f / 16384.0f, Vector { 0.01f, -0.02f, 0.0f } };
+    pool.forEach(out, [&](const VectorArray& chunk, size_t offset) {
+        VectorArray o { out.slice(offset, chunk.length) };
+        c.convert(raw + offset, o);
+    });
+}
+
+struct Kernel {
+    const char* name;
+    void (*run)(ParallelPool&);
+};
+
+const Kernel kernels[] {
+    { "GravityRemoval::linear", linear },
+    { "GravityRemoval::heading", heading },
+    { "Quaternion::swingTwist", swingTwist },
+    { "RawConverter::convert", convert },
+};
+}  // namespace
+
+int main(int argc, char** argv) {
+    uint32_t seed { 13 };
+    for (size_t i {}; i < N; i++) {
+        const Vector v { bench::noise(seed), bench::noise(seed),
+                         bench::noise(seed) };
+        qs.set(i, Quaternion::fromRotationVector(v * 3.0f));
+        raw[i].x = static_cast<int16_t>(bench::noise(seed) * 16384.0f);
+        raw[i].y = static_cast<int16_t>(bench::noise(seed) * 16384.0f);
+        raw[i].z = static_cast<int16_t>(16384.0f + bench::noise(seed) * 512.0f);
+    }
+    bench::fill(accels, Vector { 0.0f, 0.0f, 9.81f }, 0.5f, seed);
+
+    size_t workers { ParallelPool {}.size() };
+    if (argc > 1) {
+        workers = static_cast<size_t>(atoi(argv[1]));
+    }
+    printf("%zu samples, 1 to %zu workers\n", N, workers);
+
+    for (const Kernel& k : kernels) {
+        double single {};
+        for (size_t w { 1 }; w <= workers; w++) {
+            ParallelPool pool { w };
+            const double t { bench::best([&]() { k.run(pool); }) };
+            single = w == 1 ? t : single;
+
+            char name[48];
+            snprintf(name, sizeof(name), "%s, %zu", k.name, pool.size());
+            bench::report(name, t, N);
+            printf("%32s speedup %.2fx\n", "", single / t);
+        }
+    }
+
+    return 0;
+}
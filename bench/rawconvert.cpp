@@ -0,0 +1,114 @@
+/**
+ * @file rawconvert.cpp
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief RawConverter::convert against the four-pass calibration chain at
+ * sensor-burst sizes.
+ *
+ * The reference converts a burst the usual way, one pass per step over the
+ * output: RawVector3i16::toVector, subtract the bias, multiply by the
+ * misalignment matrix, rotate to the body frame. Bursts of 32 to 512
+ * samples (a FIFO read to a DMA block) are converted repeatedly in a
+ * buffer that stays in L1, so the figures are compute cost, not memory.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "bench.h"
+
+namespace {
+const size_t MAX_BURST { 512 };
+const size_t TOTAL { 1 << 22 };
+const float SCALE { 1.0f / 16384.0f };
+
+RawVector3i16 raw[MAX_BURST];
+float ox[MAX_BURST], oy[MAX_BURST], oz[MAX_BURST];
+float rx[MAX_BURST], ry[MAX_BURST], rz[MAX_BURST];
+
+/**
+ * @brief Time both paths on bursts of @p burst samples.
+ *
+ * @param burst Samples per burst.
+ * @param c Converter.
+ * @param bias Bias.
+ * @param m Misalignment/scale correction.
+ * @param rotation Sensor to body rotation.
+ */
+void compare(
+    size_t burst,
+    const RawConverter& c,
+    const Vector& bias,
+    const Matrix3x3& m,
+    const Quaternion& rotation) {
+    VectorArray out { ox, oy, oz, burst };
+    VectorArray ref { rx, ry, rz, burst };
+    const size_t bursts { TOTAL / burst };
+
+    const double tFused { bench::best([&]() {
+        for (size_t b {}; b < bursts; b++) {
+            c.convert(raw, out);
+        }
+        bench::sink = ox[0];
+    }) };
+    const double tChain { bench::best([&]() {
+        for (size_t b {}; b < bursts; b++) {
+            for (size_t i {}; i < burst; i++) {
+                ref.set(i, raw[i].toVector(SCALE));
+            }
+            for (size_t i {}; i < burst; i++) {
+                ref.set(i, ref.get(i) - bias);
+            }
+            for (size_t i {}; i < burst; i++) {
+                ref.set(i, m * ref.get(i));
+            }
+            for (size_t i {}; i < burst; i++) {
+                ref.set(i, rotation.rotate(ref.get(i)));
+            }
+        }
+        bench::sink = rx[0];
+    }) };
+
+    float worst {};
+    for (size_t i {}; i < burst; i++) {
+        const float e { (out.get(i) - ref.get(i)).norm() };
+        worst = e > worst ? e : worst;
+    }
+
+    char name[48];
+    snprintf(name, sizeof(name), "convert, burst %zu", burst);
+    bench::report(name, tFused, bursts * burst);
+    snprintf(name, sizeof(name), "four passes, burst %zu", burst);
+    bench::report(name, tChain, bursts * burst);
+    printf("%32s max difference %g\n", "", worst);
+}
+}  // namespace
+
+int main() {
+    uint32_t seed { 19 };
+    for (size_t i {}; i < MAX_BURST; i++) {
+        raw[i].x = static_cast<int16_t>(bench::noise(seed) * 2000.0f);
+        raw[i].y = static_cast<int16_t>(bench::noise(seed) * 2000.0f);
+        raw[i].z = static_cast<int16_t>(16384.0f + bench::noise(seed) * 500.0f);
+    }
+
+    const Vector bias { 0.01f, -0.02f, 0.015f };
+    const float k[9] {
+        1.01f, 0.002f, -0.001f, 0.0f, 0.99f, 0.003f, 0.0f, 0.0f, 1.02f,
+    };
+    const Matrix3x3 m { k };
+    const Quaternion rotation {
+        Quaternion::fromRotationVector(Vector { 0.0f, 0.0f, 1.5707963f })
+    };
+    const RawConverter c { SCALE, bias, m, rotation };
+
+    compare(32, c, bias, m, rotation);
+    compare(64, c, bias, m, rotation);
+    compare(128, c, bias, m, rotation);
+    compare(256, c, bias, m, rotation);
+    compare(512, c, bias, m, rotation);
+
+    return 0;
+}
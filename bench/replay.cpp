@@ -0,0 +1,119 @@
+/**
+ * @file replay.cpp
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief ReplayScheduler throughput in samples per second per core.
+ *
+ * Sixteen logs from 20k to 2M samples (prefixes of one recorded stream)
+ * are replayed through a ComplementaryFilter and scored, first whole and
+ * then split into 100k-sample segments with a 5k warm-up, on pools of 1 to
+ * N workers (hardware concurrency, or the first argument). The RMS error
+ * of the longest log is printed so the split can be checked against the
+ * whole replay.
+ *
+ * Build with -DCST_PARALLEL -pthread, ReplayReport has no time without it.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include <stdlib.h>
+#include "bench.h"
+
+namespace {
+const size_t N { 2000000 };
+const size_t LOGS { 16 };
+const size_t MAX_JOBS { 64 };
+const float DT { 1e-3f };
+
+float gx[N], gy[N], gz[N];
+float ax[N], ay[N], az[N];
+
+VectorArray gyro { gx, gy, gz, N };
+VectorArray accel { ax, ay, az, N };
+
+/**
+ * @brief Replay body: tilt error of a ComplementaryFilter, level truth.
+ * Heading is left out, accelerometer updates do not observe it.
+ */
+void replay(void*, ReplayJob& job) {
+    const Vector up { 0.0f, 0.0f, 1.0f };
+    ComplementaryFilter f {};
+    for (size_t i { job.start }; i < job.end; i++) {
+        f.update(gyro.get(i), accel.get(i), DT);
+        if (i >= job.begin) {
+            const float c { f.orientation().rotate(up).z };
+            job.metrics.add(acosf(c < 1.0f ? c : 1.0f));
+        }
+    }
+}
+
+/**
+ * @brief Time one schedule on pools of 1 to @p workers.
+ *
+ * @param name Schedule name.
+ * @param scheduler Planned scheduler.
+ * @param workers Largest pool.
+ */
+void schedule(const char* name, ReplayScheduler& scheduler, size_t workers) {
+    ReplayMetrics perLog[LOGS];
+
+    for (size_t w { 1 }; w <= workers; w++) {
+        ParallelPool pool { w };
+        ReplayReport best {};
+        for (size_t r {}; r < 3; r++) {
+            const ReplayReport report {
+                scheduler.run(pool, replay, nullptr, perLog)
+            };
+            best = r == 0 || report.seconds < best.seconds ? report : best;
+        }
+
+        printf(
+            "%-8s %zu workers %3zu jobs %8.2f Msamples/s/core"
+            "  rms %.6f\n",
+            name,
+            best.workers,
+            best.jobs,
+            best.perCore() * 1e-6f,
+            perLog[LOGS - 1].rms());
+    }
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    uint32_t seed { 17 };
+    bench::fill(gyro, Vector { 0.0f, 0.0f, 0.0f }, 0.05f, seed);
+    bench::fill(accel, Vector { 0.0f, 0.0f, -9.81f }, 0.3f, seed);
+
+    size_t lengths[LOGS];
+    for (size_t l {}; l < LOGS; l++) {
+        // 20k to 2M, geometric
+        lengths[l] = static_cast<size_t>(20000.0f * powf(1.36f, l));
+        lengths[l] = lengths[l] < N ? lengths[l] : N;
+    }
+    lengths[LOGS - 1] = N;
+    bool splittable[LOGS];
+    for (size_t l {}; l < LOGS; l++) {
+        splittable[l] = true;
+    }
+
+    size_t workers { ParallelPool {}.size() };
+    if (argc > 1) {
+        workers = static_cast<size_t>(atoi(argv[1]));
+    }
+
+    ReplayJob jobs[MAX_JOBS];
+    ReplayScheduler whole { jobs, MAX_JOBS };
+    whole.plan(lengths, nullptr, LOGS);
+    schedule("whole", whole, workers);
+
+    ReplayJob segments[MAX_JOBS * 2];
+    ReplayScheduler split { segments, MAX_JOBS * 2 };
+    split.setSplit(100000, 5000);
+    split.plan(lengths, splittable, LOGS);
+    schedule("split", split, workers);
+
+    return 0;
+}
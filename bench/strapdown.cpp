@@ -0,0 +1,97 @@
+/**
+ * @file strapdown.cpp
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Strapdown::replay against a loop of Strapdown::update.
+ *
+ * Throughput of both paths on a 1M-sample log, and the largest attitude
+ * difference between them over 1000 samples of a slow (small angle) and a
+ * fast (large angle per sample) log.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "bench.h"
+
+namespace {
+const size_t N { 1000000 };
+float gx[N], gy[N], gz[N];
+float ax[N], ay[N], az[N];
+float qw[N], qx[N], qy[N], qz[N];
+
+/**
+ * @brief Largest angle between the attitudes of @c update and @c replay.
+ *
+ * @param gyro Rates.
+ * @param accel Specific forces.
+ * @param dt Sample period.
+ * @return Radians.
+ */
+float divergence(const VectorArray& gyro, const VectorArray& accel, float dt) {
+    QuaternionArray att { qw, qx, qy, qz, gyro.length };
+    VectorArray none {};
+    Strapdown batch {};
+    batch.replay(gyro, accel, dt, att, none, none);
+
+    Strapdown scalar {};
+    float worst {};
+    for (size_t i {}; i < gyro.length; i++) {
+        scalar.update(gyro.get(i), accel.get(i), dt);
+        const float d { fabsf(scalar.orientation().dot(att.get(i))) };
+        const float e { 2.0f * acosf(d < 1.0f ? d : 1.0f) };
+        worst = e > worst ? e : worst;
+    }
+
+    return worst;
+}
+}  // namespace
+
+int main() {
+    uint32_t seed { 1 };
+    VectorArray gyro { gx, gy, gz, N };
+    VectorArray accel { ax, ay, az, N };
+    bench::fill(gyro, Vector { 0.1f, -0.2f, 0.05f }, 0.5f, seed);
+    bench::fill(accel, Vector { 0.0f, 0.0f, -9.81f }, 0.2f, seed);
+    const float dt { 1e-3f };
+
+    const double tUpdate { bench::best([&]() {
+        Strapdown s {};
+        for (size_t i {}; i < N; i++) {
+            s.update(gyro.get(i), accel.get(i), dt);
+        }
+        bench::sink = s.position().x;
+    }) };
+    bench::report("update loop", tUpdate, N);
+
+    QuaternionArray att { qw, qx, qy, qz, N };
+    VectorArray none {};
+    const double tReplay { bench::best([&]() {
+        Strapdown s {};
+        s.replay(gyro, accel, dt, att, none, none);
+        bench::sink = s.position().x;
+    }) };
+    bench::report("replay, attitudes out", tReplay, N);
+
+    const double tBare { bench::best([&]() {
+        Strapdown s {};
+        QuaternionArray skip {};
+        s.replay(gyro, accel, dt, skip, none, none);
+        bench::sink = s.position().x;
+    }) };
+    bench::report("replay, final state only", tBare, N);
+
+    const VectorArray force { accel.slice(0, 1000) };
+    const VectorArray slow { gyro.slice(0, 1000) };
+    printf("max divergence, 1 ms step: %g rad\n", divergence(slow, force, dt));
+
+    // about 1 rad per sample, far outside the series range
+    VectorArray fast { gyro.slice(0, 1000) };
+    bench::fill(fast, Vector { 3.0f, -2.0f, 1.0f }, 1.0f, seed);
+    printf("max divergence, 0.3 s step: %g rad\n",
+           divergence(fast, force, 0.3f));
+
+    return 0;
+}
@@ -0,0 +1,243 @@
+/**
+ * @file allan.cpp
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Streaming overlapping Allan variance.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "allan.h"
+
+AllanVariance::AllanVariance() :
+    history {},
+    head { 0 },
+    stored { 0 },
+    pending { 0 },
+    theta {},
+    reference {},
+    period { 1.0f },
+    taus { 0 } {
+    reset();
+}
+
+size_t AllanVariance::configure(
+    float tau0,
+    const VectorArray& buffer,
+    size_t perDecade) {
+    history = buffer;
+    period = tau0;
+    taus = 0;
+
+    const size_t largest { buffer.length > 0 ? (buffer.length - 1) / 2 : 0 };
+    const float step { perDecade > 0 ? 1.0f / static_cast<float>(perDecade)
+                                     : 1.0f };
+
+    for (size_t j {}; taus < ALLAN_MAX_TAUS; j++) {
+        const size_t m {
+            static_cast<size_t>(powf(10.0f, step * static_cast<float>(j)))
+        };
+        if (m > largest) {
+            break;
+        }
+        if (taus == 0 || m > clusters[taus - 1]) {
+            clusters[taus++] = m;
+        }
+    }
+
+    reset();
+
+    return taus;
+}
+
+void AllanVariance::reset() {
+    for (size_t j {}; j < ALLAN_MAX_TAUS; j++) {
+        sums[0][j] = 0.0;
+        sums[1][j] = 0.0;
+        sums[2][j] = 0.0;
+        terms[j] = 0;
+    }
+    theta = Vector {};
+    reference = Vector {};
+    stored = 0;
+    pending = 0;
+    head = 0;
+
+    if (!history.empty()) {
+        history.set(0, theta);
+        stored = 1;
+    }
+}
+
+void AllanVariance::push(const Vector& rate) {
+    if (stored == 1) {
+        reference = rate;
+    }
+
+    theta += (rate - reference) * period;
+    head = head + 1 == history.length ? 0 : head + 1;
+    history.set(head, theta);
+    stored++;
+
+    if (++pending == history.length) {
+        rebase();
+    }
+}
+
+void AllanVariance::rebase() {
+    float* CST_RESTRICT hx { history.x };
+    float* CST_RESTRICT hy { history.y };
+    float* CST_RESTRICT hz { history.z };
+    const float tx { theta.x };
+    const float ty { theta.y };
+    const float tz { theta.z };
+    const size_t n { history.length };
+
+    CST_IVDEP
+    for (size_t i {}; i < n; i++) {
+        hx[i] -= tx;
+        hy[i] -= ty;
+        hz[i] -= tz;
+    }
+    theta = Vector {};
+    pending = 0;
+}
+
+void AllanVariance::add(const Vector& rate) {
+    if (stored == 0) {
+        return;
+    }
+
+    push(rate);
+
+    const size_t len { history.length };
+    for (size_t j {}; j < taus; j++) {
+        const size_t m { clusters[j] };
+        if (stored < 2 * m + 1) {
+            break;
+        }
+        const size_t i1 { head >= m ? head - m : head + len - m };
+        const size_t i2 { i1 >= m ? i1 - m : i1 + len - m };
+        const Vector d {
+            theta - history.get(i1) * 2.0f + history.get(i2)
+        };
+        sums[0][j] += cst::sqr(d.x);
+        sums[1][j] += cst::sqr(d.y);
+        sums[2][j] += cst::sqr(d.z);
+        terms[j]++;
+    }
+}
+
+void AllanVariance::add(const VectorArray& rates) {
+    addChunks(rates, nullptr);
+}
+
+void AllanVariance::add(ParallelPool& pool, const VectorArray& rates) {
+    addChunks(rates, &pool);
+}
+
+void AllanVariance::addChunks(const VectorArray& rates, ParallelPool* pool) {
+    if (stored == 0 || taus == 0) {
+        return;
+    }
+
+    const size_t chunk { history.length - 2 * clusters[taus - 1] };
+
+    for (size_t start {}; start < rates.length; start += chunk) {
+        Chunk c { this, head, stored, 0 };
+        c.n = rates.length - start < chunk ? rates.length - start : chunk;
+
+        for (size_t i {}; i < c.n; i++) {
+            push(rates.get(start + i));
+        }
+
+        if (pool != nullptr) {
+            pool->run(taus, accumulateKernel, &c, 1);
+        } else {
+            accumulate(c, 0, taus);
+        }
+    }
+}
+
+void AllanVariance::accumulateKernel(void* chunk, size_t begin, size_t end) {
+    const Chunk& c { *static_cast<const Chunk*>(chunk) };
+    c.self->accumulate(c, begin, end);
+}
+
+void AllanVariance::accumulate(const Chunk& chunk, size_t begin, size_t end) {
+    const size_t len { history.length };
+    const size_t n { chunk.n };
+    const size_t before { chunk.before };
+    const float* CST_RESTRICT hx { history.x };
+    const float* CST_RESTRICT hy { history.y };
+    const float* CST_RESTRICT hz { history.z };
+
+    // one cluster time at a time over the chunk: three ring cursors
+    for (size_t j { begin }; j < end; j++) {
+        const size_t m { clusters[j] };
+        if (before + n < 2 * m + 1) {
+            break;
+        }
+        // skip the samples that do not have 2m predecessors yet
+        const size_t skip { before < 2 * m ? 2 * m - before : 0 };
+        size_t p0 { (chunk.first + 1 + skip) % len };
+        size_t p1 { (p0 + len - m) % len };
+        size_t p2 { (p1 + len - m) % len };
+        double sx {};
+        double sy {};
+        double sz {};
+
+        for (size_t i { skip }; i < n; i++) {
+            const float dx { hx[p0] - 2.0f * hx[p1] + hx[p2] };
+            const float dy { hy[p0] - 2.0f * hy[p1] + hy[p2] };
+            const float dz { hz[p0] - 2.0f * hz[p1] + hz[p2] };
+            sx += dx * dx;
+            sy += dy * dy;
+            sz += dz * dz;
+            p0 = p0 + 1 == len ? 0 : p0 + 1;
+            p1 = p1 + 1 == len ? 0 : p1 + 1;
+            p2 = p2 + 1 == len ? 0 : p2 + 1;
+        }
+
+        sums[0][j] += sx;
+        sums[1][j] += sy;
+        sums[2][j] += sz;
+        terms[j] += n - skip;
+    }
+}
+
+size_t AllanVariance::size() const {
+    return taus;
+}
+
+float AllanVariance::tau(size_t j) const {
+    return static_cast<float>(clusters[j]) * period;
+}
+
+size_t AllanVariance::count(size_t j) const {
+    return terms[j];
+}
+
+Vector AllanVariance::variance(size_t j) const {
+    if (terms[j] == 0) {
+        return Vector {};
+    }
+
+    const double t { tau(j) };
+    const double k { 1.0 / (2.0 * t * t * static_cast<double>(terms[j])) };
+
+    return Vector {
+        static_cast<float>(sums[0][j] * k),
+        static_cast<float>(sums[1][j] * k),
+        static_cast<float>(sums[2][j] * k),
+    };
+}
+
+Vector AllanVariance::deviation(size_t j) const {
+    const Vector v { variance(j) };
+
+    return Vector { sqrtf(v.x), sqrtf(v.y), sqrtf(v.z) };
+}
@@ -0,0 +1,233 @@
+/**
+ * @file allan.h
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Streaming overlapping Allan variance.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef __LIB_CUSTOM_TYPE_ALLAN_H__
+#define __LIB_CUSTOM_TYPE_ALLAN_H__
+
+#include <stddef.h>
+#include "def.h"
+#include "vector.h"
+#include "arrays.h"
+#include "parallel.h"
+
+/**
+ * @brief Maximum number of cluster times.
+ */
+const size_t ALLAN_MAX_TAUS { 64 };
+
+/**
+ * @class AllanVariance
+ * @brief Overlapping Allan variance of a rate stream (gyro or accel),
+ * for log-spaced cluster times, computed from cumulative sums.
+ *
+ * The integrated signal @f$\theta_k=\tau_0\sum_{i<k}(\omega_i-\omega_0)@f$
+ * is kept in a caller-owned ring buffer, and for each cluster size @f$m@f$
+ * @f$\sigma^2(m\tau_0)=\frac{1}{2m^2\tau_0^2 K}\sum_k
+ * (\theta_{k+2m}-2\theta_{k+m}+\theta_k)^2@f$ is accumulated as samples
+ * arrive. The cost is O(taus) per sample and the memory is the ring: a log
+ * of any length is streamed chunk by chunk and never held in memory.
+ * The second difference is blind to a constant offset, so the ring is
+ * rebased (the latest @f$\theta@f$ subtracted from every entry) once per
+ * ring length: its values then only span one ring of drift, whatever the
+ * log length, and single precision holds. The sums of squares run over
+ * tens of millions of terms and are kept in double.
+ */
+class AllanVariance {
+  private:
+    /**
+     * @brief Ring of integrated samples.
+     */
+    VectorArray history;
+    /**
+     * @brief Ring position of the latest integrated sample.
+     */
+    size_t head;
+    /**
+     * @brief Number of integrated samples stored so far (samples + 1).
+     */
+    size_t stored;
+    /**
+     * @brief Samples pushed since the last #rebase.
+     */
+    size_t pending;
+    /**
+     * @brief Latest integrated sample.
+     */
+    Vector theta;
+    /**
+     * @brief Rate removed from every sample (the first one), takes a large
+     * constant such as gravity out of @f$\theta@f$.
+     */
+    Vector reference;
+    /**
+     * @brief Sample period (seconds).
+     */
+    float period;
+    /**
+     * @brief Cluster sizes, increasing.
+     */
+    size_t clusters[ALLAN_MAX_TAUS];
+    /**
+     * @brief Number of cluster sizes.
+     */
+    size_t taus;
+    /**
+     * @brief Sums of squared second differences, per axis.
+     */
+    double sums[3][ALLAN_MAX_TAUS];
+    /**
+     * @brief Number of terms in each sum.
+     */
+    size_t terms[ALLAN_MAX_TAUS];
+
+    /**
+     * @brief Append an integrated sample to the ring.
+     *
+     * @param rate Rate sample.
+     */
+    void push(const Vector& rate);
+
+    /**
+     * @brief Subtract the latest integrated sample from the ring.
+     */
+    void rebase();
+
+    /**
+     * @brief Chunk just pushed into the ring, shared by the cluster time
+     * loops.
+     */
+    struct Chunk {
+        AllanVariance* self;
+        size_t first;
+        size_t before;
+        size_t n;
+    };
+
+    /**
+     * @brief Accumulate cluster times [@p begin, @p end) over a chunk.
+     * Each one writes only its own sums and count.
+     *
+     * @param chunk Chunk.
+     * @param begin First cluster time index.
+     * @param end Index past the last one.
+     */
+    void accumulate(const Chunk& chunk, size_t begin, size_t end);
+
+    /**
+     * @brief ParallelKernel adapter of #accumulate.
+     *
+     * @param chunk Chunk.
+     * @param begin First cluster time index.
+     * @param end Index past the last one.
+     */
+    static void accumulateKernel(void* chunk, size_t begin, size_t end);
+
+    /**
+     * @brief Integrate @p rates chunk by chunk and accumulate every chunk,
+     * on @p pool if not null.
+     *
+     * @param rates Angular rates or specific forces.
+     * @param pool Workers, or nullptr.
+     */
+    void addChunks(const VectorArray& rates, ParallelPool* pool);
+
+  public:
+    /**
+     * @brief Construct an unconfigured AllanVariance object.
+     */
+    AllanVariance();
+
+    /**
+     * @brief Set the sample period, the ring and the cluster times, and
+     * reset. The largest cluster is (buffer.length - 1) / 2 samples; a
+     * larger ring lets #add(const VectorArray&) work on longer chunks.
+     *
+     * @param tau0 Sample period (seconds).
+     * @param buffer Ring storage, owned by the caller.
+     * @param perDecade Cluster times per decade.
+     * @return Number of cluster times.
+     */
+    size_t configure(float tau0, const VectorArray& buffer, size_t perDecade);
+
+    /**
+     * @brief Forget all samples, keep the configuration.
+     */
+    void reset();
+
+    /**
+     * @brief Add one rate sample.
+     *
+     * @param rate Angular rate or specific force.
+     */
+    void add(const Vector& rate);
+
+    /**
+     * @brief Add rate samples. They are integrated into the ring in chunks
+     * of up to (ring length - 2 max cluster), then each cluster time is
+     * accumulated over the chunk in its own loop.
+     *
+     * @param rates Angular rates or specific forces.
+     */
+    void add(const VectorArray& rates);
+
+    /**
+     * @brief Add rate samples, accumulating the cluster times of each chunk
+     * on a ParallelPool. The cluster times are independent (each loop
+     * writes its own sums), and the three axes of a cluster time stay
+     * in the same loop. The result matches #add(const VectorArray&).
+     *
+     * @param pool Workers.
+     * @param rates Angular rates or specific forces.
+     */
+    void add(ParallelPool& pool, const VectorArray& rates);
+
+    /**
+     * @brief Number of cluster times.
+     *
+     * @return size_t
+     */
+    size_t size() const;
+
+    /**
+     * @brief Cluster time.
+     *
+     * @param j Cluster time index.
+     * @return Cluster time (seconds).
+     */
+    float tau(size_t j) const;
+
+    /**
+     * @brief Number of terms averaged for a cluster time.
+     *
+     * @param j Cluster time index.
+     * @return 0 until 2m + 1 samples are seen.
+     */
+    size_t count(size_t j) const;
+
+    /**
+     * @brief Allan variance of each axis.
+     *
+     * @param j Cluster time index.
+     * @return Vector
+     */
+    Vector variance(size_t j) const;
+
+    /**
+     * @brief Allan deviation of each axis.
+     *
+     * @param j Cluster time index.
+     * @return Vector
+     */
+    Vector deviation(size_t j) const;
+};
+
+#endif /* __LIB_CUSTOM_TYPE_ALLAN_H__ */
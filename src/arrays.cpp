@@ -0,0 +1,118 @@
+/**
+ * @file arrays.cpp
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Structure-of-arrays views over Vector and Quaternion buffers.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "arrays.h"
+
+namespace {
+/**
+ * @brief Clamp a sub-range to an array of @p length elements.
+ *
+ * @param length Array length.
+ * @param offset Requested offset, clamped in place.
+ * @param count Requested count, clamped in place.
+ */
+void clampRange(size_t length, size_t& offset, size_t& count) {
+    if (offset > length) {
+        offset = length;
+    }
+    if (count > length - offset) {
+        count = length - offset;
+    }
+}
+}  // namespace
+
+VectorArray::VectorArray(float* xs, float* ys, float* zs, size_t n) :
+    x { xs },
+    y { ys },
+    z { zs },
+    length { n } {}
+
+size_t VectorArray::size() const {
+    return length;
+}
+
+bool VectorArray::empty() const {
+    return length == 0;
+}
+
+Vector VectorArray::get(size_t idx) const {
+    return Vector {
+        x[idx],
+        y[idx],
+        z[idx],
+    };
+}
+
+void VectorArray::set(size_t idx, const Vector& v) {
+    x[idx] = v.x;
+    y[idx] = v.y;
+    z[idx] = v.z;
+}
+
+VectorArray VectorArray::slice(size_t offset, size_t count) const {
+    clampRange(length, offset, count);
+
+    return VectorArray {
+        x + offset,
+        y + offset,
+        z + offset,
+        count,
+    };
+}
+
+QuaternionArray::QuaternionArray(
+    float* ws,
+    float* xs,
+    float* ys,
+    float* zs,
+    size_t n) :
+    w { ws },
+    x { xs },
+    y { ys },
+    z { zs },
+    length { n } {}
+
+size_t QuaternionArray::size() const {
+    return length;
+}
+
+bool QuaternionArray::empty() const {
+    return length == 0;
+}
+
+Quaternion QuaternionArray::get(size_t idx) const {
+    return Quaternion {
+        w[idx],
+        x[idx],
+        y[idx],
+        z[idx],
+    };
+}
+
+void QuaternionArray::set(size_t idx, const Quaternion& q) {
+    w[idx] = q.w;
+    x[idx] = q.x;
+    y[idx] = q.y;
+    z[idx] = q.z;
+}
+
+QuaternionArray QuaternionArray::slice(size_t offset, size_t count) const {
+    clampRange(length, offset, count);
+
+    return QuaternionArray {
+        w + offset,
+        x + offset,
+        y + offset,
+        z + offset,
+        count,
+    };
+}
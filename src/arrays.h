@@ -0,0 +1,191 @@
+/**
+ * @file arrays.h
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Structure-of-arrays views over Vector and Quaternion buffers.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef __LIB_CUSTOM_TYPE_ARRAYS_H__
+#define __LIB_CUSTOM_TYPE_ARRAYS_H__
+
+#include <stddef.h>
+#include "def.h"
+#include "vector.h"
+#include "quaternion.h"
+
+/**
+ * @class VectorArray
+ * @brief Non-owning structure-of-arrays view over 3D vectors.
+ *
+ * Each axis lives in its own contiguous buffer so that batch kernels can
+ * process one component at a time. The view never allocates, the buffers are
+ * owned by the caller (static arrays, DMA buffers, ...).
+ */
+class VectorArray {
+  public:
+    /**
+     * @brief Components along x-axis.
+     */
+    float* x;
+    /**
+     * @brief Components along y-axis.
+     */
+    float* y;
+    /**
+     * @brief Components along z-axis.
+     */
+    float* z;
+    /**
+     * @brief Number of vectors in the view.
+     */
+    size_t length;
+
+    /**
+     * @brief Construct a new VectorArray view.
+     * If no arguments provided, it creates an empty view.
+     *
+     * @param xs x-axis buffer.
+     * @param ys y-axis buffer.
+     * @param zs z-axis buffer.
+     * @param n Number of elements in each buffer.
+     */
+    explicit VectorArray(
+        float* xs = nullptr,
+        float* ys = nullptr,
+        float* zs = nullptr,
+        size_t n = 0);
+
+    /**
+     * @brief Number of vectors in the view.
+     *
+     * @return size_t
+     */
+    size_t size() const;
+
+    /**
+     * @brief Verify if the view is empty.
+     *
+     * @return true if it holds no elements.
+     * @return false otherwise.
+     */
+    bool empty() const;
+
+    /**
+     * @brief Fetch the vector at @p idx.
+     *
+     * @param idx Element's index.
+     * @return Vector
+     */
+    Vector get(size_t idx) const;
+
+    /**
+     * @brief Store a vector at @p idx.
+     *
+     * @param idx Element's index.
+     * @param v #Vector.
+     */
+    void set(size_t idx, const Vector& v);
+
+    /**
+     * @brief Creates a view over a sub-range of the array.
+     * The range is clamped to the array's bounds.
+     *
+     * @param offset Index of the first element.
+     * @param count Number of elements.
+     * @return VectorArray
+     */
+    VectorArray slice(size_t offset, size_t count) const;
+};
+
+/**
+ * @class QuaternionArray
+ * @brief Non-owning structure-of-arrays view over quaternions.
+ */
+class QuaternionArray {
+  public:
+    /**
+     * @brief Scalar parts.
+     */
+    float* w;
+    /**
+     * @brief @f$i@f$ of the vector parts.
+     */
+    float* x;
+    /**
+     * @brief @f$j@f$ of the vector parts.
+     */
+    float* y;
+    /**
+     * @brief @f$k@f$ of the vector parts.
+     */
+    float* z;
+    /**
+     * @brief Number of quaternions in the view.
+     */
+    size_t length;
+
+    /**
+     * @brief Construct a new QuaternionArray view.
+     * If no arguments provided, it creates an empty view.
+     *
+     * @param ws Scalar parts buffer.
+     * @param xs @f$i@f$ buffer.
+     * @param ys @f$j@f$ buffer.
+     * @param zs @f$k@f$ buffer.
+     * @param n Number of elements in each buffer.
+     */
+    explicit QuaternionArray(
+        float* ws = nullptr,
+        float* xs = nullptr,
+        float* ys = nullptr,
+        float* zs = nullptr,
+        size_t n = 0);
+
+    /**
+     * @brief Number of quaternions in the view.
+     *
+     * @return size_t
+     */
+    size_t size() const;
+
+    /**
+     * @brief Verify if the view is empty.
+     *
+     * @return true if it holds no elements.
+     * @return false otherwise.
+     */
+    bool empty() const;
+
+    /**
+     * @brief Fetch the quaternion at @p idx.
+     *
+     * @param idx Element's index.
+     * @return Quaternion
+     */
+    Quaternion get(size_t idx) const;
+
+    /**
+     * @brief Store a quaternion at @p idx.
+     *
+     * @param idx Element's index.
+     * @param q #Quaternion.
+     */
+    void set(size_t idx, const Quaternion& q);
+
+    /**
+     * @brief Creates a view over a sub-range of the array.
+     * The range is clamped to the array's bounds.
+     *
+     * @param offset Index of the first element.
+     * @param count Number of elements.
+     * @return QuaternionArray
+     */
+    QuaternionArray slice(size_t offset, size_t count) const;
+};
+
+#endif /* __LIB_CUSTOM_TYPE_ARRAYS_H__ */
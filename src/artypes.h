@@ -16,5 +16,30 @@
 #include "vector.h"
 #include "quaternion.h"
 #include "matrix.h"
+#include "arrays.h"
+#include "dualquaternion.h"
+#include "kinematics.h"
+#include "ik.h"
+#include "strapdown.h"
+#include "preintegration.h"
+#include "eskf.h"
+#include "ukf.h"
+#include "complementary.h"
+#include "stationary.h"
+#include "magcalibration.h"
+#include "rawvector.h"
+#include "axisremap.h"
+#include "statistics.h"
+#include "allan.h"
+#include "filter.h"
+#include "spectrum.h"
+#include "resample.h"
+#include "differentiate.h"
+#include "gravity.h"
+#include "parallel.h"
+#include "pipeline.h"
+#include "packet.h"
+#include "replay.h"
+#include "checkpoint.h"
 
 #endif /* __LIB_CUSTOM_TYPE_CUSTOMR_H__ */
@@ -0,0 +1,306 @@
+/**
+ * @file axisremap.h
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Compile-time axis permutations and sign flips.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef __LIB_CUSTOM_TYPE_AXISREMAP_H__
+#define __LIB_CUSTOM_TYPE_AXISREMAP_H__
+
+#include <stddef.h>
+#include "def.h"
+#include "vector.h"
+#include "quaternion.h"
+#include "matrix.h"
+#include "arrays.h"
+
+/**
+ * @brief Source axis descriptors, negate them to flip the sign.
+ */
+const int AXIS_X { 1 };
+const int AXIS_Y { 2 };
+const int AXIS_Z { 3 };
+
+namespace cst {
+/**
+ * @brief Index [0..2] of an axis descriptor.
+ *
+ * @param a Axis descriptor.
+ * @return size_t
+ */
+constexpr size_t axisIndex(int a) {
+    return static_cast<size_t>((a < 0 ? -a : a) - 1);
+}
+
+/**
+ * @brief Select the component of @p a among @p x, @p y, @p z, with its
+ * sign. @p a is a template argument: this folds to a move or a negation.
+ *
+ * @param a Axis descriptor.
+ * @param x Component along x-axis.
+ * @param y Component along y-axis.
+ * @param z Component along z-axis.
+ * @return Component.
+ */
+constexpr float axisPick(int a, float x, float y, float z) {
+    return a < 0 ? -(axisIndex(a) == 0 ? x : (axisIndex(a) == 1 ? y : z))
+                 : (axisIndex(a) == 0 ? x : (axisIndex(a) == 1 ? y : z));
+}
+
+/**
+ * @brief Descriptor of the output axis fed by source axis @p j in the
+ * remap (x, y, z), for the inverse remap.
+ *
+ * @param j Source axis descriptor (positive).
+ * @param x Descriptor of the output x-axis.
+ * @param y Descriptor of the output y-axis.
+ * @param z Descriptor of the output z-axis.
+ * @return Axis descriptor.
+ */
+constexpr int axisInverse(int j, int x, int y, int z) {
+    return x == j ? AXIS_X
+        : x == -j ? -AXIS_X
+        : y == j  ? AXIS_Y
+        : y == -j ? -AXIS_Y
+        : z == j  ? AXIS_Z
+                  : -AXIS_Z;
+}
+
+/**
+ * @brief Descriptor of remap @p b applied after remap (x, y, z).
+ *
+ * @param b Axis descriptor of the second remap.
+ * @param x Descriptor of the first remap's x-axis.
+ * @param y Descriptor of the first remap's y-axis.
+ * @param z Descriptor of the first remap's z-axis.
+ * @return Axis descriptor.
+ */
+constexpr int axisCompose(int b, int x, int y, int z) {
+    return (b < 0 ? -1 : 1)
+        * (axisIndex(b) == 0 ? x : (axisIndex(b) == 1 ? y : z));
+}
+}  // namespace cst
+
+/**
+ * @class AxisRemap
+ * @brief Fixed axis permutation with sign flips, resolved at compile time.
+ *
+ * Each template argument is the source axis of an output axis, e.g.
+ * @c AxisRemap<AXIS_Y,AXIS_X,-AXIS_Z> maps @f$(x,y,z)@f$ to
+ * @f$(y,x,-z)@f$ (NED to ENU). Applying a remap is register moves and
+ * negations, no multiply. It is the signed permutation matrix #matrix, so it
+ * composes with a calibration matrix through #compose.
+ *
+ * Quaternions are remapped as rotations expressed in the new frame,
+ * @f$PRP^T@f$: the vector part is remapped and, for a reflection
+ * (@f$\det P=-1@f$), negated.
+ *
+ * @tparam X Source of the output x-axis.
+ * @tparam Y Source of the output y-axis.
+ * @tparam Z Source of the output z-axis.
+ */
+template <int X, int Y, int Z>
+class AxisRemap {
+    static_assert(
+        cst::axisIndex(X) < 3 && cst::axisIndex(Y) < 3 && cst::axisIndex(Z) < 3
+            && cst::axisIndex(X) != cst::axisIndex(Y)
+            && cst::axisIndex(X) != cst::axisIndex(Z)
+            && cst::axisIndex(Y) != cst::axisIndex(Z),
+        "AxisRemap needs a permutation of AXIS_X, AXIS_Y and AXIS_Z");
+
+  public:
+    /**
+     * @brief Output axes descriptors.
+     */
+    static constexpr int AX { X };
+    static constexpr int AY { Y };
+    static constexpr int AZ { Z };
+
+    /**
+     * @brief Determinant of #matrix: sign flips times the permutation
+     * parity.
+     */
+    static constexpr int DET {
+        (X < 0 ? -1 : 1) * (Y < 0 ? -1 : 1) * (Z < 0 ? -1 : 1)
+        * ((cst::axisIndex(Y) + 1) % 3 == cst::axisIndex(Z) ? 1 : -1)
+    };
+
+    /**
+     * @brief Remap undoing this one.
+     */
+    typedef AxisRemap<
+        cst::axisInverse(AXIS_X, X, Y, Z),
+        cst::axisInverse(AXIS_Y, X, Y, Z),
+        cst::axisInverse(AXIS_Z, X, Y, Z)>
+        Inverse;
+
+    /**
+     * @brief This remap followed by @p Next.
+     *
+     * @tparam Next AxisRemap applied second.
+     */
+    template <class Next>
+    using Then = AxisRemap<
+        cst::axisCompose(Next::AX, X, Y, Z),
+        cst::axisCompose(Next::AY, X, Y, Z),
+        cst::axisCompose(Next::AZ, X, Y, Z)>;
+
+    /**
+     * @brief Signed permutation matrix.
+     *
+     * @return Matrix3x3
+     */
+    static Matrix3x3 matrix() {
+        return compose(Matrix3x3::identity());
+    }
+
+    /**
+     * @brief Remap applied after a calibration matrix, @f$P\,M@f$: the rows
+     * of @p m are permuted and negated.
+     *
+     * @param m Calibration matrix.
+     * @return Matrix3x3
+     */
+    static Matrix3x3 compose(const Matrix3x3& m) {
+        return Matrix3x3::merge(
+                   apply(m.col(0)),
+                   apply(m.col(1)),
+                   apply(m.col(2)));
+    }
+
+    /**
+     * @brief Remap a Vector.
+     *
+     * @param v Vector.
+     * @return Vector
+     */
+    static Vector apply(const Vector& v) {
+        return Vector {
+            cst::axisPick(X, v.x, v.y, v.z),
+            cst::axisPick(Y, v.x, v.y, v.z),
+            cst::axisPick(Z, v.x, v.y, v.z),
+        };
+    }
+
+    /**
+     * @brief Express a rotation in the remapped frame.
+     *
+     * @param q Quaternion.
+     * @return Quaternion
+     */
+    static Quaternion apply(const Quaternion& q) {
+        const Vector u { apply(Vector { q.x, q.y, q.z }) };
+
+        return DET > 0 ? Quaternion { q.w, u.x, u.y, u.z }
+                       : Quaternion { q.w, -u.x, -u.y, -u.z };
+    }
+
+    /**
+     * @brief Remap an array of vectors.
+     *
+     * @param in Vectors.
+     * @param out Remapped vectors, same length as @p in, may be @p in.
+     */
+    static void apply(const VectorArray& in, VectorArray& out) {
+        const float* xs { in.x };
+        const float* ys { in.y };
+        const float* zs { in.z };
+        float* ox { out.x };
+        float* oy { out.y };
+        float* oz { out.z };
+        const size_t n { in.length };
+
+        // every element is read before it is written, in place is fine
+        CST_IVDEP
+        for (size_t i {}; i < n; i++) {
+            const float x { xs[i] };
+            const float y { ys[i] };
+            const float z { zs[i] };
+            ox[i] = cst::axisPick(X, x, y, z);
+            oy[i] = cst::axisPick(Y, x, y, z);
+            oz[i] = cst::axisPick(Z, x, y, z);
+        }
+    }
+
+    /**
+     * @brief Express an array of rotations in the remapped frame.
+     *
+     * @param in Quaternions.
+     * @param out Remapped quaternions, same length as @p in, may be @p in.
+     */
+    static void apply(const QuaternionArray& in, QuaternionArray& out) {
+        const float* ws { in.w };
+        const float* xs { in.x };
+        const float* ys { in.y };
+        const float* zs { in.z };
+        float* ow { out.w };
+        float* ox { out.x };
+        float* oy { out.y };
+        float* oz { out.z };
+        const size_t n { in.length };
+
+        CST_IVDEP
+        for (size_t i {}; i < n; i++) {
+            const float x { DET > 0 ? xs[i] : -xs[i] };
+            const float y { DET > 0 ? ys[i] : -ys[i] };
+            const float z { DET > 0 ? zs[i] : -zs[i] };
+            ow[i] = ws[i];
+            ox[i] = cst::axisPick(X, x, y, z);
+            oy[i] = cst::axisPick(Y, x, y, z);
+            oz[i] = cst::axisPick(Z, x, y, z);
+        }
+    }
+
+    /**
+     * @brief Remapped view of an array, no copy. Only valid without sign
+     * flips.
+     *
+     * @param in Vectors.
+     * @return VectorArray sharing the buffers of @p in.
+     */
+    static VectorArray view(const VectorArray& in) {
+        static_assert(
+            X > 0 && Y > 0 && Z > 0,
+            "AxisRemap::view cannot flip signs");
+        float* const axes[3] { in.x, in.y, in.z };
+
+        return VectorArray {
+            axes[cst::axisIndex(X)],
+            axes[cst::axisIndex(Y)],
+            axes[cst::axisIndex(Z)],
+            in.length,
+        };
+    }
+};
+
+template <int X, int Y, int Z>
+constexpr int AxisRemap<X, Y, Z>::AX;
+template <int X, int Y, int Z>
+constexpr int AxisRemap<X, Y, Z>::AY;
+template <int X, int Y, int Z>
+constexpr int AxisRemap<X, Y, Z>::AZ;
+template <int X, int Y, int Z>
+constexpr int AxisRemap<X, Y, Z>::DET;
+
+/**
+ * @brief NED to ENU (its own inverse).
+ */
+typedef AxisRemap<AXIS_Y, AXIS_X, -AXIS_Z> NedToEnu;
+
+/**
+ * @brief Sensor mounted rotated by +90 degrees about z, sensor to board.
+ */
+typedef AxisRemap<-AXIS_Y, AXIS_X, AXIS_Z> RotateZ90;
+
+/**
+ * @brief Sensor mounted upside down (180 degrees about x), sensor to board.
+ */
+typedef AxisRemap<AXIS_X, -AXIS_Y, -AXIS_Z> RotateX180;
+
+#endif /* __LIB_CUSTOM_TYPE_AXISREMAP_H__ */
@@ -0,0 +1,254 @@
+/**
+ * @file checkpoint.h
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Filter state snapshots for split-and-resume replay.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef __LIB_CUSTOM_TYPE_CHECKPOINT_H__
+#define __LIB_CUSTOM_TYPE_CHECKPOINT_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "def.h"
+#include "vector.h"
+#include "quaternion.h"
+#include "matrix.h"
+
+namespace cst {
+/**
+ * @brief Copy a Vector into a state field.
+ *
+ * @param v Vector.
+ * @param out x, y, z.
+ */
+inline void store(const Vector& v, float out[3]) {
+    out[0] = v.x;
+    out[1] = v.y;
+    out[2] = v.z;
+}
+
+/**
+ * @brief Copy a Quaternion into a state field.
+ *
+ * @param q Quaternion.
+ * @param out w, x, y, z.
+ */
+inline void store(const Quaternion& q, float out[4]) {
+    out[0] = q.w;
+    out[1] = q.x;
+    out[2] = q.y;
+    out[3] = q.z;
+}
+
+/**
+ * @brief Copy a Matrix3x3 into a state field.
+ *
+ * @param m Matrix3x3.
+ * @param out Coefficients, row-major.
+ */
+inline void store(const Matrix3x3& m, float out[9]) {
+    for (size_t r {}; r < 3; r++) {
+        for (size_t c {}; c < 3; c++) {
+            out[3 * r + c] = m.coeff(r, c);
+        }
+    }
+}
+
+/**
+ * @brief Vector of a state field.
+ *
+ * @param in x, y, z.
+ * @return Vector
+ */
+inline Vector loadVector(const float in[3]) {
+    return Vector { in[0], in[1], in[2] };
+}
+
+/**
+ * @brief Quaternion of a state field.
+ *
+ * @param in w, x, y, z.
+ * @return Quaternion
+ */
+inline Quaternion loadQuaternion(const float in[4]) {
+    return Quaternion::fromArray(in);
+}
+
+/**
+ * @brief Matrix3x3 of a state field.
+ *
+ * @param in Coefficients, row-major.
+ * @return Matrix3x3
+ */
+inline Matrix3x3 loadMatrix(const float in[9]) {
+    return Matrix3x3 { in };
+}
+
+/**
+ * @brief Write a filter state as bytes. The layout is the in-memory one;
+ * State structs hold only float and fixed-width integer fields, so it is
+ * the same on 32- and 64-bit hosts of the same byte order. Read it back
+ * with the same library version.
+ *
+ * @tparam S State struct (trivially copyable).
+ * @param state State.
+ * @param out Buffer of at least @c sizeof(S) bytes.
+ * @return Number of bytes written.
+ */
+template <class S>
+size_t serialise(const S& state, uint8_t* out) {
+#if defined(__GNUC__)
+    static_assert(__is_trivially_copyable(S), "state must be a flat struct");
+#endif
+    memcpy(out, &state, sizeof(S));
+
+    return sizeof(S);
+}
+
+/**
+ * @brief Read a filter state written by #serialise.
+ *
+ * @tparam S State struct (trivially copyable).
+ * @param state State, unchanged on failure.
+ * @param in Bytes.
+ * @param n Number of bytes.
+ * @return false if @p n is not @c sizeof(S).
+ */
+template <class S>
+bool deserialise(S& state, const uint8_t* in, size_t n) {
+#if defined(__GNUC__)
+    static_assert(__is_trivially_copyable(S), "state must be a flat struct");
+#endif
+    if (n != sizeof(S)) {
+        return false;
+    }
+    memcpy(&state, in, sizeof(S));
+
+    return true;
+}
+}  // namespace cst
+
+/**
+ * @class Checkpoints
+ * @brief Filter states captured every @c interval samples of a log, in a
+ * caller buffer.
+ *
+ * A reference run captures the states; later replays of the same log are
+ * then split into chunks (ReplayScheduler::setSplit) that each resume from
+ * the checkpoint at or before their first replayed sample instead of a
+ * fresh state. With the same filter code, a chunk replayed from an exact
+ * checkpoint is bit-identical to the serial run and needs no warm-up; a
+ * modified filter uses the warm-up overlap to move away from the reference
+ * state before its samples are scored.
+ *
+ * @tparam F Filter with a @c State type, @c checkpoint() and
+ * @c restore(const State&).
+ */
+template <class F>
+class Checkpoints {
+  private:
+    /**
+     * @brief State buffer.
+     */
+    typename F::State* states;
+    /**
+     * @brief Capacity of #states.
+     */
+    size_t capacity;
+    /**
+     * @brief Samples between checkpoints.
+     */
+    size_t every;
+    /**
+     * @brief Number of checkpoints captured.
+     */
+    size_t count;
+
+  public:
+    /**
+     * @brief Construct a new Checkpoints object.
+     *
+     * @param buffer State buffer.
+     * @param size Capacity of @p buffer.
+     * @param interval Samples between checkpoints, at least 1.
+     */
+    Checkpoints(typename F::State* buffer, size_t size, size_t interval) :
+        states { buffer },
+        capacity { size },
+        every { interval > 0 ? interval : 1 },
+        count { 0 } {}
+
+    /**
+     * @brief Drop the checkpoints.
+     */
+    void reset() {
+        count = 0;
+    }
+
+    /**
+     * @brief Capture the filter state before sample @p sample is
+     * processed, if it falls on the interval. Call it for every sample of
+     * the reference run, in order.
+     *
+     * @param filter Filter.
+     * @param sample Index of the next sample.
+     * @return false if the buffer is full.
+     */
+    bool capture(const F& filter, size_t sample) {
+        if (sample % every != 0 || sample / every < count) {
+            return true;
+        }
+        if (count == capacity) {
+            return false;
+        }
+        states[count++] = filter.checkpoint();
+
+        return true;
+    }
+
+    /**
+     * @brief Restore the last checkpoint at or before @p sample.
+     *
+     * @param filter Filter.
+     * @param sample First sample to replay.
+     * @return Sample the filter resumes at (replay from there), 0 with a
+     * fresh state if there is no checkpoint.
+     */
+    size_t resume(F& filter, size_t sample) const {
+        if (count == 0) {
+            return 0;
+        }
+
+        const size_t k { sample / every < count ? sample / every : count - 1 };
+        filter.restore(states[k]);
+
+        return k * every;
+    }
+
+    /**
+     * @brief Number of checkpoints captured.
+     *
+     * @return size_t
+     */
+    size_t size() const {
+        return count;
+    }
+
+    /**
+     * @brief Samples between checkpoints.
+     *
+     * @return size_t
+     */
+    size_t interval() const {
+        return every;
+    }
+};
+
+#endif /* __LIB_CUSTOM_TYPE_CHECKPOINT_H__ */
@@ -0,0 +1,123 @@
+/**
+ * @file complementary.cpp
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Quaternion complementary filter.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "complementary.h"
+#include "checkpoint.h"
+
+ComplementaryFilter::ComplementaryFilter(
+    float aTau,
+    float mTau,
+    float tol,
+    float g) :
+    attitude {},
+    accelTau { aTau },
+    magTau { mTau },
+    tolerance { tol },
+    gravity { g },
+    weight { 0.0f } {}
+
+void ComplementaryFilter::setTimeConstants(float aTau, float mTau) {
+    accelTau = aTau;
+    magTau = mTau;
+}
+
+void ComplementaryFilter::setAccelTolerance(float tol, float g) {
+    tolerance = tol;
+    gravity = g;
+}
+
+void ComplementaryFilter::reset(const Quaternion& q) {
+    attitude = q;
+}
+
+void ComplementaryFilter::tilt(
+    const Vector& gyro,
+    const Vector& accel,
+    float dt) {
+    attitude *= Quaternion::fromRotationVector(gyro * dt);
+    // renormalisation below is first order, no square root
+
+    const float n { accel.norm() };
+    weight = n > 0.0f ? 1.0f - fabsf(n / gravity - 1.0f) / tolerance : 0.0f;
+    if (weight <= 0.0f) {
+        weight = 0.0f;
+        attitude *= 1.5f - 0.5f * attitude.normSqr();
+        return;
+    }
+
+    // at rest the specific force points up, (0, 0, -1) in NED:
+    // shortest arc from a to up is (|a| - a.z, -a.y, a.x, 0)
+    const Vector a { attitude.rotate(accel) };
+    const Quaternion correction {
+        n - a.z > cst::EPSILON * n
+            ? Quaternion { n - a.z, -a.y, a.x, 0.0f }.normalised()
+            : Quaternion { 0.0f, 1.0f, 0.0f, 0.0f }
+    };
+    const float alpha { weight * dt / (accelTau + dt) };
+
+    attitude = Quaternion::nlerp(Quaternion {}, correction, alpha) * attitude;
+    attitude *= 1.5f - 0.5f * attitude.normSqr();
+}
+
+void ComplementaryFilter::update(
+    const Vector& gyro,
+    const Vector& accel,
+    float dt) {
+    tilt(gyro, accel, dt);
+}
+
+void ComplementaryFilter::update(
+    const Vector& gyro,
+    const Vector& accel,
+    const Vector& mag,
+    float dt) {
+    tilt(gyro, accel, dt);
+
+    // horizontal field towards north, (1, 0, 0): the shortest arc is a
+    // rotation about the vertical, (|m| + m.x, 0, 0, -m.y)
+    const Vector m { attitude.rotate(mag) };
+    const float h { sqrtf(cst::sqr(m.x) + cst::sqr(m.y)) };
+    if (h <= 0.0f) {
+        return;
+    }
+
+    const Quaternion correction {
+        h + m.x > cst::EPSILON * h
+            ? Quaternion { h + m.x, 0.0f, 0.0f, -m.y }.normalised()
+            : Quaternion { 0.0f, 0.0f, 0.0f, 1.0f }
+    };
+    const float beta { dt / (magTau + dt) };
+
+    attitude = Quaternion::nlerp(Quaternion {}, correction, beta) * attitude;
+    attitude *= 1.5f - 0.5f * attitude.normSqr();
+}
+
+Quaternion ComplementaryFilter::orientation() const {
+    return attitude;
+}
+
+float ComplementaryFilter::accelWeight() const {
+    return weight;
+}
+
+ComplementaryFilter::State ComplementaryFilter::checkpoint() const {
+    State state;
+    cst::store(attitude, state.attitude);
+    state.weight = weight;
+
+    return state;
+}
+
+void ComplementaryFilter::restore(const State& state) {
+    attitude = cst::loadQuaternion(state.attitude);
+    weight = state.weight;
+}
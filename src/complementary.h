@@ -0,0 +1,181 @@
+/**
+ * @file complementary.h
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Quaternion complementary filter.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef __LIB_CUSTOM_TYPE_COMPLEMENTARY_H__
+#define __LIB_CUSTOM_TYPE_COMPLEMENTARY_H__
+
+#include "def.h"
+#include "vector.h"
+#include "quaternion.h"
+
+/**
+ * @brief Checkpoint of a ComplementaryFilter (configuration excluded).
+ */
+struct ComplementaryState {
+    /**
+     * @brief Body to NED rotation (w, x, y, z).
+     */
+    float attitude[4];
+    /**
+     * @brief Accel weight of the last update.
+     */
+    float weight;
+};
+
+/**
+ * @class ComplementaryFilter
+ * @brief Tilt/heading complementary filter in the NED frame.
+ *
+ * The gyro is integrated every sample (high-pass path), then the attitude
+ * is pulled towards the accelerometer tilt and the magnetometer heading
+ * (low-pass path). Corrections are shortest-arc rotations built with
+ * #Quaternion::fromTwoVectors and applied partially with
+ * #Quaternion::nlerp, so no trigonometric function is evaluated.
+ * The tilt correction rotates about a horizontal axis and the heading
+ * correction about the vertical, they do not disturb each other.
+ *
+ * The crossover is set with time constants. The accelerometer weight is
+ * adaptive: it fades out as the measured norm departs from gravity (linear
+ * acceleration), and is exposed through #accelWeight.
+ */
+class ComplementaryFilter {
+  private:
+    /**
+     * @brief Body to NED rotation.
+     */
+    Quaternion attitude;
+    /**
+     * @brief Tilt correction time constant (seconds).
+     */
+    float accelTau;
+    /**
+     * @brief Heading correction time constant (seconds).
+     */
+    float magTau;
+    /**
+     * @brief Relative norm error at which the accel weight reaches 0.
+     */
+    float tolerance;
+    /**
+     * @brief Expected accelerometer norm at rest.
+     */
+    float gravity;
+    /**
+     * @brief Accel weight used by the last update, in [0, 1].
+     */
+    float weight;
+
+    /**
+     * @brief Gyro integration and tilt correction.
+     *
+     * @param gyro Angular rate (rad/s).
+     * @param accel Specific force.
+     * @param dt Sample period (seconds).
+     */
+    void tilt(const Vector& gyro, const Vector& accel, float dt);
+
+  public:
+    /**
+     * @brief Checkpoint type.
+     */
+    typedef ComplementaryState State;
+
+    /**
+     * @brief Construct a new ComplementaryFilter object.
+     *
+     * @param aTau Tilt correction time constant (seconds).
+     * @param mTau Heading correction time constant (seconds).
+     * @param tol Relative accel norm error at which tilt correction stops.
+     * @param g Accelerometer norm at rest, in the accelerometer's unit.
+     */
+    explicit ComplementaryFilter(
+        float aTau = 1.0f,
+        float mTau = 5.0f,
+        float tol = 0.1f,
+        float g = 9.80665f);
+
+    /**
+     * @brief Set the crossover time constants.
+     *
+     * @param aTau Tilt correction time constant (seconds).
+     * @param mTau Heading correction time constant (seconds).
+     */
+    void setTimeConstants(float aTau, float mTau);
+
+    /**
+     * @brief Set the adaptive accel weight parameters.
+     *
+     * @param tol Relative accel norm error at which tilt correction stops.
+     * @param g Accelerometer norm at rest.
+     */
+    void setAccelTolerance(float tol, float g);
+
+    /**
+     * @brief Set the attitude.
+     *
+     * @param q Body to NED rotation.
+     */
+    void reset(const Quaternion& q = Quaternion {});
+
+    /**
+     * @brief Gyro + accelerometer update (tilt only, heading drifts).
+     *
+     * @param gyro Angular rate (rad/s), body frame.
+     * @param accel Specific force, body frame.
+     * @param dt Sample period (seconds).
+     */
+    void update(const Vector& gyro, const Vector& accel, float dt);
+
+    /**
+     * @brief Gyro + accelerometer + magnetometer update.
+     *
+     * @param gyro Angular rate (rad/s), body frame.
+     * @param accel Specific force, body frame.
+     * @param mag Magnetic field, body frame (any unit).
+     * @param dt Sample period (seconds).
+     */
+    void update(
+        const Vector& gyro,
+        const Vector& accel,
+        const Vector& mag,
+        float dt);
+
+    /**
+     * @brief Body to NED rotation.
+     *
+     * @return Quaternion
+     */
+    Quaternion orientation() const;
+
+    /**
+     * @brief Accel weight used by the last update.
+     *
+     * @return 1 for a norm equal to gravity, 0 beyond the tolerance.
+     */
+    float accelWeight() const;
+
+    /**
+     * @brief Snapshot of the filter state.
+     *
+     * @return State
+     */
+    State checkpoint() const;
+
+    /**
+     * @brief Resume from a snapshot; the configuration is kept.
+     *
+     * @param state State.
+     */
+    void restore(const State& state);
+};
+
+#endif /* __LIB_CUSTOM_TYPE_COMPLEMENTARY_H__ */
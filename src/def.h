@@ -13,8 +13,38 @@
 #ifndef __LIB_CUSTOM_TYPES_DEF_H__
 #define __LIB_CUSTOM_TYPES_DEF_H__
 
+#include <stddef.h>
+
+#if defined(__GNUC__)
+/**
+ * @brief Non-aliasing hint for batch kernels' buffers.
+ */
+#define CST_RESTRICT __restrict__
+#else
+#define CST_RESTRICT
+#endif
+
+/**
+ * @brief Tells the compiler a batch loop has no loop-carried dependencies.
+ * Kernels touching many SoA buffers exceed the runtime alias checks the
+ * vectoriser is willing to emit, restrict on locals is not enough.
+ */
+#if defined(__clang__)
+#define CST_IVDEP _Pragma("clang loop vectorize(assume_safety)")
+#elif defined(__GNUC__)
+#define CST_IVDEP _Pragma("GCC ivdep")
+#else
+#define CST_IVDEP
+#endif
+
 namespace cst {
 const float RAD2DEG { 57.295779513082320876798154814105 };
+const float PI { 3.14159265358979323846f };
+
+/**
+ * @brief Tolerance used to detect degenerate configurations.
+ */
+const float EPSILON { 1e-6f };
 
 /**
  * @brief Computes the square of a number.
@@ -25,6 +55,24 @@ const float RAD2DEG { 57.295779513082320876798154814105 };
 inline float sqr(float f) {
     return f * f;
 }
+
+/**
+ * @brief Pairwise sum, each halving step is element-wise so it vectorises
+ * without reassociation and accumulates less round-off than a running sum.
+ *
+ * @param s Values, overwritten.
+ * @param n Number of values, a power of 2.
+ * @return Sum of the values.
+ */
+inline float pairwiseSum(float s[], size_t n) {
+    for (size_t h { n / 2 }; h > 0; h /= 2) {
+        for (size_t k {}; k < h; k++) {
+            s[k] += s[k + h];
+        }
+    }
+
+    return s[0];
+}
 }  // namespace cst
 
 #endif /* __LIB_CUSTOM_TYPES_DEF_H__ */
@@ -0,0 +1,285 @@
+/**
+ * @file differentiate.cpp
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Angular velocity and acceleration from orientation sequences.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "differentiate.h"
+
+namespace {
+/**
+ * @brief Intervals of @p n + 1 timestamps, formed in double and stored in
+ * float.
+ *
+ * @param ts Timestamps (seconds), @p n + 1 of them.
+ * @param hs Intervals, @p n of them.
+ * @param n Number of intervals.
+ */
+inline void steps(const double* ts, float* hs, size_t n) {
+    for (size_t i {}; i < n; i++) {
+        hs[i] = static_cast<float>(ts[i + 1] - ts[i]);
+    }
+}
+
+/**
+ * @brief Rates of @p n consecutive increments, @f$2\log(q_i^*q_{i+1})/h_i@f$,
+ * through the series. A constant @p n gives a vectorised loop.
+ *
+ * @param hs Intervals, @p n of them.
+ * @param ws Quaternion w-components, @p n + 1 of them.
+ * @param xs Quaternion x-components.
+ * @param ys Quaternion y-components.
+ * @param zs Quaternion z-components.
+ * @param ox Rate x-components, @p n of them.
+ * @param oy Rate y-components.
+ * @param oz Rate z-components.
+ * @param n Number of increments.
+ * @return Number of increments beyond #DIFFERENTIATE_SERIES_LIMIT.
+ */
+inline size_t rates(
+    const float* CST_RESTRICT hs,
+    const float* CST_RESTRICT ws,
+    const float* CST_RESTRICT xs,
+    const float* CST_RESTRICT ys,
+    const float* CST_RESTRICT zs,
+    float* CST_RESTRICT ox,
+    float* CST_RESTRICT oy,
+    float* CST_RESTRICT oz,
+    size_t n) {
+    size_t large {};
+
+    CST_IVDEP
+    for (size_t i {}; i < n; i++) {
+        // d = q_i^* q_i+1
+        const float aw { ws[i] };
+        const float ax { xs[i] };
+        const float ay { ys[i] };
+        const float az { zs[i] };
+        const float bw { ws[i + 1] };
+        const float bx { xs[i + 1] };
+        const float by { ys[i + 1] };
+        const float bz { zs[i + 1] };
+        const float dw { aw * bw + ax * bx + ay * by + az * bz };
+        const float dx { aw * bx - ax * bw - ay * bz + az * by };
+        const float dy { aw * by + ax * bz - ay * bw - az * bx };
+        const float dz { aw * bz - ax * by + ay * bx - az * bw };
+
+        // shortest path; 2 atan(r) / (r c) with r = s / c, series to r^8
+        const float sgn { dw < 0.0f ? -1.0f : 1.0f };
+        const float c { sgn * dw };
+        const float r2 { (dx * dx + dy * dy + dz * dz) / (c * c) };
+        large += !(r2 < DIFFERENTIATE_SERIES_LIMIT);
+        const float p {
+            1.0f
+            - r2 * (1.0f / 3.0f
+                    - r2 * (1.0f / 5.0f - r2 * (1.0f / 7.0f - r2 / 9.0f)))
+        };
+        const float k { 2.0f * sgn * p / (c * hs[i]) };
+        ox[i] = k * dx;
+        oy[i] = k * dy;
+        oz[i] = k * dz;
+    }
+
+    return large;
+}
+
+/**
+ * @brief Interpolate, in place, the rates at the middles of
+ * @f$[t_i,t_{i+1}]@f$ and @f$[t_{i+1},t_{i+2}]@f$ at @f$t_{i+1}@f$.
+ *
+ * @param hs Intervals, @p n + 1 of them.
+ * @param xs Rate x-components, @p n + 1 of them.
+ * @param ys Rate y-components.
+ * @param zs Rate z-components.
+ * @param n Number of outputs.
+ */
+inline void blend(
+    const float* CST_RESTRICT hs,
+    float* CST_RESTRICT xs,
+    float* CST_RESTRICT ys,
+    float* CST_RESTRICT zs,
+    size_t n) {
+    // each element is read before it is written
+    CST_IVDEP
+    for (size_t i {}; i < n; i++) {
+        const float h1 { hs[i] };
+        const float h2 { hs[i + 1] };
+        const float inv { 1.0f / (h1 + h2) };
+        const float a { h2 * inv };
+        const float b { h1 * inv };
+        xs[i] = a * xs[i] + b * xs[i + 1];
+        ys[i] = a * ys[i] + b * ys[i + 1];
+        zs[i] = a * zs[i] + b * zs[i + 1];
+    }
+}
+
+/**
+ * @brief Derivative of a vector sequence, forward (@p central false, reads
+ * @f$w_i,w_{i+1}@f$) or three-point on uneven steps (reads
+ * @f$w_{i-1},w_i,w_{i+1}@f$).
+ *
+ * @param hs Intervals, @f$h_i=t_{i+1}-t_i@f$ (@f$h_{-1}@f$ is read by
+ * the three-point form).
+ * @param wx Input x-components.
+ * @param wy Input y-components.
+ * @param wz Input z-components.
+ * @param ax Derivative x-components, @p n of them.
+ * @param ay Derivative y-components.
+ * @param az Derivative z-components.
+ * @param n Number of outputs.
+ * @param central Three-point instead of forward differences.
+ */
+inline void derivative(
+    const float* CST_RESTRICT hs,
+    const float* CST_RESTRICT wx,
+    const float* CST_RESTRICT wy,
+    const float* CST_RESTRICT wz,
+    float* CST_RESTRICT ax,
+    float* CST_RESTRICT ay,
+    float* CST_RESTRICT az,
+    size_t n,
+    bool central) {
+    if (!central) {
+        CST_IVDEP
+        for (size_t i {}; i < n; i++) {
+            const float inv { 1.0f / hs[i] };
+            ax[i] = (wx[i + 1] - wx[i]) * inv;
+            ay[i] = (wy[i + 1] - wy[i]) * inv;
+            az[i] = (wz[i + 1] - wz[i]) * inv;
+        }
+        return;
+    }
+
+    // (h1^2 (w+ - w) + h2^2 (w - w-)) / (h1 h2 (h1 + h2))
+    CST_IVDEP
+    for (size_t i {}; i < n; i++) {
+        const float h1 { hs[i - 1] };
+        const float h2 { hs[i] };
+        const float inv { 1.0f / (h1 * h2 * (h1 + h2)) };
+        const float a { h1 * h1 * inv };
+        const float b { h2 * h2 * inv };
+        ax[i] = a * (wx[i + 1] - wx[i]) + b * (wx[i] - wx[i - 1]);
+        ay[i] = a * (wy[i + 1] - wy[i]) + b * (wy[i] - wy[i - 1]);
+        az[i] = a * (wz[i + 1] - wz[i]) + b * (wz[i] - wz[i - 1]);
+    }
+}
+}  // namespace
+
+size_t Differentiator::angularVelocity(
+    const double* times,
+    const QuaternionArray& qs,
+    VectorArray& omega,
+    bool central) {
+    const size_t n { qs.length };
+    if (n < 2) {
+        if (n == 1) {
+            omega.set(0, Vector {});
+        }
+        return 0;
+    }
+
+    // forward: rate of [t_i, t_i+1] at i; central: one step later, so the
+    // blend can run in place. Full blocks have a constant trip count.
+    const size_t shift { central ? 1u : 0u };
+    float hs[DIFFERENTIATE_BLOCK + 1];
+    size_t large {};
+    size_t i {};
+
+    for (; i + DIFFERENTIATE_BLOCK <= n - 1; i += DIFFERENTIATE_BLOCK) {
+        steps(times + i, hs, DIFFERENTIATE_BLOCK);
+        large += rates(
+            hs, qs.w + i, qs.x + i, qs.y + i, qs.z + i,
+            omega.x + shift + i, omega.y + shift + i, omega.z + shift + i,
+            DIFFERENTIATE_BLOCK);
+    }
+    steps(times + i, hs, n - 1 - i);
+    large += rates(
+        hs, qs.w + i, qs.x + i, qs.y + i, qs.z + i,
+        omega.x + shift + i, omega.y + shift + i, omega.z + shift + i,
+        n - 1 - i);
+
+    if (large > 0) {
+        for (size_t j {}; j < n - 1; j++) {
+            const Quaternion d { qs.get(j).conjugate() * qs.get(j + 1) };
+            const float r2 {
+                (d.x * d.x + d.y * d.y + d.z * d.z) / (d.w * d.w)
+            };
+            if (!(r2 < DIFFERENTIATE_SERIES_LIMIT)) {
+                omega.set(
+                    j + shift,
+                    d.toRotationVector()
+                        / static_cast<float>(times[j + 1] - times[j]));
+            }
+        }
+    }
+
+    if (!central) {
+        omega.set(n - 1, omega.get(n - 2));
+        return large;
+    }
+
+    for (i = 0; i + DIFFERENTIATE_BLOCK <= n - 2; i += DIFFERENTIATE_BLOCK) {
+        steps(times + i, hs, DIFFERENTIATE_BLOCK + 1);
+        blend(
+            hs, omega.x + 1 + i, omega.y + 1 + i, omega.z + 1 + i,
+            DIFFERENTIATE_BLOCK);
+    }
+    steps(times + i, hs, n - 1 - i);
+    blend(
+        hs, omega.x + 1 + i, omega.y + 1 + i, omega.z + 1 + i,
+        n - 2 - i);
+    omega.set(0, omega.get(1));
+
+    return large;
+}
+
+void Differentiator::angularAcceleration(
+    const double* times,
+    const VectorArray& omega,
+    VectorArray& alpha,
+    bool central) {
+    const size_t n { omega.length };
+    if (n < 2) {
+        if (n == 1) {
+            alpha.set(0, Vector {});
+        }
+        return;
+    }
+
+    // forward: outputs [0, n - 1); central: outputs [1, n - 1)
+    // hs[0] is the interval before the block, read by the central form
+    const size_t first { central ? 1u : 0u };
+    const size_t last { n - 1 };
+    float hs[DIFFERENTIATE_BLOCK + 1];
+    size_t i { first };
+
+    for (; i + DIFFERENTIATE_BLOCK <= last; i += DIFFERENTIATE_BLOCK) {
+        steps(times + i - first, hs, DIFFERENTIATE_BLOCK + first);
+        derivative(
+            hs + first, omega.x + i, omega.y + i, omega.z + i,
+            alpha.x + i, alpha.y + i, alpha.z + i,
+            DIFFERENTIATE_BLOCK, central);
+    }
+    steps(times + i - first, hs, last - i + first);
+    derivative(
+        hs + first, omega.x + i, omega.y + i, omega.z + i,
+        alpha.x + i, alpha.y + i, alpha.z + i,
+        last - i, central);
+
+    if (central) {
+        alpha.set(
+            0,
+            (omega.get(1) - omega.get(0))
+                / static_cast<float>(times[1] - times[0]));
+    }
+    alpha.set(
+        n - 1,
+        (omega.get(n - 1) - omega.get(n - 2))
+            / static_cast<float>(times[n - 1] - times[n - 2]));
+}
@@ -0,0 +1,87 @@
+/**
+ * @file differentiate.h
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Angular velocity and acceleration from orientation sequences.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef __LIB_CUSTOM_TYPE_DIFFERENTIATE_H__
+#define __LIB_CUSTOM_TYPE_DIFFERENTIATE_H__
+
+#include <stddef.h>
+#include "def.h"
+#include "vector.h"
+#include "quaternion.h"
+#include "arrays.h"
+
+/**
+ * @brief Largest squared half-angle tangent handled by the series in
+ * #Differentiator::angularVelocity (about 11 degrees per sample).
+ */
+const float DIFFERENTIATE_SERIES_LIMIT { 0.01f };
+
+/**
+ * @brief Samples per block in #Differentiator (constant trip count).
+ */
+const size_t DIFFERENTIATE_BLOCK { 32 };
+
+/**
+ * @class Differentiator
+ * @brief Batch differentiation of timestamped orientation sequences, e.g.
+ * motion capture references compared against gyro readings.
+ *
+ * The increment between two samples is
+ * @f$\phi_i=2\log(q_i^{-1}q_{i+1})@f$, in the body frame (it is the same in
+ * the frames of @f$q_i@f$ and @f$q_{i+1}@f$), and @f$\phi_i/h_i@f$ is the
+ * rate at the middle of the interval. Forward differences assign it to
+ * @f$t_i@f$; central differences interpolate the two neighbouring rates at
+ * @f$t_i@f$, second order also on uneven timestamps.
+ *
+ * The arc tangent is replaced by its series when the half-angle tangent is
+ * small, so the whole pass vectorises. Larger increments are redone
+ * exactly in a scalar pass, which is skipped when there are none.
+ *
+ * Timestamps are double seconds: each interval is formed in double and
+ * only then rounded to float, so absolute times of long logs do not
+ * quantise the steps.
+ */
+class Differentiator {
+  public:
+    /**
+     * @brief Body angular velocity.
+     *
+     * @param times Timestamps (seconds), strictly increasing.
+     * @param qs Unit quaternions (body to nav), @p qs.length of them.
+     * @param omega Angular velocity (rad/s), same length as @p qs.
+     * @param central Central instead of forward differences.
+     * @return Number of increments beyond the series, computed exactly.
+     */
+    static size_t angularVelocity(
+        const double* times,
+        const QuaternionArray& qs,
+        VectorArray& omega,
+        bool central = false);
+
+    /**
+     * @brief Body angular acceleration, derivative of an angular velocity
+     * sequence (body and nav derivatives coincide up to the rotation).
+     *
+     * @param times Timestamps (seconds), strictly increasing.
+     * @param omega Angular velocity (rad/s).
+     * @param alpha Angular acceleration (rad/s^2), same length as
+     * @p omega, not @p omega.
+     * @param central Central instead of forward differences.
+     */
+    static void angularAcceleration(
+        const double* times,
+        const VectorArray& omega,
+        VectorArray& alpha,
+        bool central = false);
+};
+
+#endif /* __LIB_CUSTOM_TYPE_DIFFERENTIATE_H__ */
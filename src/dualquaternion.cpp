@@ -0,0 +1,265 @@
+/**
+ * @file dualquaternion.cpp
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Dual quaternion type and skinning kernel.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "dualquaternion.h"
+
+DualQuaternion::DualQuaternion(const Quaternion& r, const Quaternion& d) :
+    real { r },
+    dual { d } {}
+
+DualQuaternion DualQuaternion::blend(
+    const DualQuaternion dqs[],
+    const float weights[],
+    size_t count) {
+    DualQuaternion acc { Quaternion { 0.0f, 0.0f, 0.0f, 0.0f } };
+
+    for (size_t i {}; i < count; i++) {
+        // shortest path: keep all real parts in the first one's hemisphere
+        float w { weights[i] };
+        if (dqs[i].real.dot(dqs[0].real) < 0.0f) {
+            w = -w;
+        }
+        acc += dqs[i] * w;
+    }
+
+    acc.normalise();
+
+    return acc;
+}
+
+void DualQuaternion::skin(
+    const QuaternionArray& realParts,
+    const QuaternionArray& dualParts,
+    const uint16_t* indices,
+    const float* weights,
+    size_t influences,
+    const VectorArray& positions,
+    const VectorArray& normals,
+    VectorArray& outPositions,
+    VectorArray& outNormals) {
+    const bool withNormals { !normals.empty() };
+    const size_t n { positions.length };
+
+    // no bone: identity transform
+    if (influences == 0) {
+        for (size_t v {}; v < n; v++) {
+            outPositions.set(v, positions.get(v));
+            if (withNormals) {
+                outNormals.set(v, normals.get(v));
+            }
+        }
+        return;
+    }
+
+    const float* CST_RESTRICT rw { realParts.w };
+    const float* CST_RESTRICT rx { realParts.x };
+    const float* CST_RESTRICT ry { realParts.y };
+    const float* CST_RESTRICT rz { realParts.z };
+    const float* CST_RESTRICT dw { dualParts.w };
+    const float* CST_RESTRICT dx { dualParts.x };
+    const float* CST_RESTRICT dy { dualParts.y };
+    const float* CST_RESTRICT dz { dualParts.z };
+
+    const float* CST_RESTRICT px { positions.x };
+    const float* CST_RESTRICT py { positions.y };
+    const float* CST_RESTRICT pz { positions.z };
+    float* CST_RESTRICT opx { outPositions.x };
+    float* CST_RESTRICT opy { outPositions.y };
+    float* CST_RESTRICT opz { outPositions.z };
+
+    CST_IVDEP
+    for (size_t v {}; v < n; v++) {
+        const uint16_t* idx { indices + v * influences };
+        const float* wgt { weights + v * influences };
+
+        // the first influence sets the hemisphere
+        const uint16_t b0 { idx[0] };
+        float aw { wgt[0] * rw[b0] };
+        float ax { wgt[0] * rx[b0] };
+        float ay { wgt[0] * ry[b0] };
+        float az { wgt[0] * rz[b0] };
+        float bw { wgt[0] * dw[b0] };
+        float bx { wgt[0] * dx[b0] };
+        float by { wgt[0] * dy[b0] };
+        float bz { wgt[0] * dz[b0] };
+
+        for (size_t k { 1 }; k < influences; k++) {
+            const uint16_t b { idx[k] };
+            const float d {
+                rw[b] * rw[b0] + rx[b] * rx[b0] + ry[b] * ry[b0]
+                + rz[b] * rz[b0]
+            };
+            const float w { d < 0.0f ? -wgt[k] : wgt[k] };
+
+            aw += w * rw[b];
+            ax += w * rx[b];
+            ay += w * ry[b];
+            az += w * rz[b];
+            bw += w * dw[b];
+            bx += w * dx[b];
+            by += w * dy[b];
+            bz += w * dz[b];
+        }
+
+        // a single reciprocal square root normalises both parts
+        const float inv { 1.0f
+                          / sqrtf(
+                              cst::sqr(aw) + cst::sqr(ax) + cst::sqr(ay)
+                              + cst::sqr(az)) };
+        aw *= inv;
+        ax *= inv;
+        ay *= inv;
+        az *= inv;
+        bw *= inv;
+        bx *= inv;
+        by *= inv;
+        bz *= inv;
+
+        // translation: 2 (q_d q_r*)
+        const float tx { 2.0f * (aw * bx - bw * ax + ay * bz - az * by) };
+        const float ty { 2.0f * (aw * by - bw * ay + az * bx - ax * bz) };
+        const float tz { 2.0f * (aw * bz - bw * az + ax * by - ay * bx) };
+
+        // rotation: t = 2 (u x p), p' = p + w t + u x t
+        const float x { px[v] };
+        const float y { py[v] };
+        const float z { pz[v] };
+        float cx { 2.0f * (ay * z - az * y) };
+        float cy { 2.0f * (az * x - ax * z) };
+        float cz { 2.0f * (ax * y - ay * x) };
+
+        opx[v] = x + aw * cx + (ay * cz - az * cy) + tx;
+        opy[v] = y + aw * cy + (az * cx - ax * cz) + ty;
+        opz[v] = z + aw * cz + (ax * cy - ay * cx) + tz;
+
+        if (withNormals) {
+            const float nx { normals.x[v] };
+            const float ny { normals.y[v] };
+            const float nz { normals.z[v] };
+            cx = 2.0f * (ay * nz - az * ny);
+            cy = 2.0f * (az * nx - ax * nz);
+            cz = 2.0f * (ax * ny - ay * nx);
+
+            outNormals.x[v] = nx + aw * cx + (ay * cz - az * cy);
+            outNormals.y[v] = ny + aw * cy + (az * cx - ax * cz);
+            outNormals.z[v] = nz + aw * cz + (ax * cy - ay * cx);
+        }
+    }
+}
+
+void DualQuaternion::skin(
+    ParallelPool& pool,
+    const QuaternionArray& realParts,
+    const QuaternionArray& dualParts,
+    const uint16_t* indices,
+    const float* weights,
+    size_t influences,
+    const VectorArray& positions,
+    const VectorArray& normals,
+    VectorArray& outPositions,
+    VectorArray& outNormals) {
+    const bool withNormals { !normals.empty() };
+
+    pool.forEach(positions, [&](const VectorArray& chunk, size_t offset) {
+        const size_t first { offset * influences };
+        const VectorArray ns {
+            withNormals ? normals.slice(offset, chunk.length) : VectorArray {}
+        };
+        VectorArray op { outPositions.slice(offset, chunk.length) };
+        VectorArray on {
+            withNormals ? outNormals.slice(offset, chunk.length)
+                        : VectorArray {}
+        };
+        skin(
+            realParts,
+            dualParts,
+            indices + first,
+            weights + first,
+            influences,
+            chunk,
+            ns,
+            op,
+            on);
+    });
+}
+
+float DualQuaternion::norm() const {
+    return real.norm();
+}
+
+void DualQuaternion::normalise() {
+    const float n { norm() };
+    real /= n;
+    dual /= n;
+}
+
+DualQuaternion DualQuaternion::normalised() const {
+    const float n { norm() };
+
+    return DualQuaternion {
+        real / n,
+        dual / n,
+    };
+}
+
+DualQuaternion DualQuaternion::conjugate() const {
+    return DualQuaternion {
+        real.conjugate(),
+        dual.conjugate(),
+    };
+}
+
+Vector DualQuaternion::translation() const {
+    const Quaternion t { dual * real.conjugate() };
+
+    return Vector {
+        2.0f * t.x,
+        2.0f * t.y,
+        2.0f * t.z,
+    };
+}
+
+Vector DualQuaternion::transformPoint(const Vector& p) const {
+    return real.rotate(p) + translation();
+}
+
+Vector DualQuaternion::transformVector(const Vector& v) const {
+    return real.rotate(v);
+}
+
+DualQuaternion DualQuaternion::operator*(const DualQuaternion& rhs) const {
+    return DualQuaternion {
+        real * rhs.real,
+        real * rhs.dual + dual * rhs.real,
+    };
+}
+
+DualQuaternion DualQuaternion::operator*(float n) const {
+    return DualQuaternion {
+        real * n,
+        dual * n,
+    };
+}
+
+DualQuaternion DualQuaternion::operator+(const DualQuaternion& rhs) const {
+    return DualQuaternion {
+        real + rhs.real,
+        dual + rhs.dual,
+    };
+}
+
+DualQuaternion& DualQuaternion::operator+=(const DualQuaternion& rhs) {
+    real += rhs.real;
+    dual += rhs.dual;
+
+    return *this;
+}
@@ -0,0 +1,224 @@
+/**
+ * @file dualquaternion.h
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Dual quaternion type and skinning kernel.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef __LIB_CUSTOM_TYPE_DUALQUATERNION_H__
+#define __LIB_CUSTOM_TYPE_DUALQUATERNION_H__
+
+#include <stdint.h>
+#include "def.h"
+#include "vector.h"
+#include "quaternion.h"
+#include "arrays.h"
+#include "parallel.h"
+
+/**
+ * @class DualQuaternion
+ * @brief Creates a rigid transform (rotation + translation) as a pair of
+ * quaternions @f$\hat{q}=q_r+\varepsilon\,q_d@f$.
+ */
+class DualQuaternion {
+  public:
+    /**
+     * @brief Real part (rotation).
+     */
+    Quaternion real;
+    /**
+     * @brief Dual part, @f$q_d=\frac{1}{2}\,t\,q_r@f$.
+     */
+    Quaternion dual;
+
+    /**
+     * @brief Construct a new DualQuaternion object.
+     * If no arguments provided, it creates the identity transform.
+     *
+     * @param r Real part.
+     * @param d Dual part.
+     */
+    explicit DualQuaternion(
+        const Quaternion& r = Quaternion {},
+        const Quaternion& d = Quaternion { 0.0f, 0.0f, 0.0f, 0.0f });
+
+    /**
+     * @brief Create a dual quaternion from a rotation and a translation.
+     * The rotation is applied first.
+     *
+     * @param q Unit rotation #Quaternion.
+     * @param t Translation #Vector.
+     * @return DualQuaternion
+     */
+    static DualQuaternion fromRotationTranslation(
+        const Quaternion& q,
+        const Vector& t) {
+        return DualQuaternion {
+            q,
+            Quaternion { 0.0f, 0.5f * t.x, 0.5f * t.y, 0.5f * t.z } * q,
+        };
+    }
+
+    /**
+     * @brief Blend transforms with dual quaternion linear blending (DLB).
+     * Antipodal quaternions are flipped to the hemisphere of the first one.
+     *
+     * @param dqs Transforms to blend.
+     * @param weights Weight of each transform.
+     * @param count Number of transforms.
+     * @return Normalised blended DualQuaternion.
+     */
+    static DualQuaternion
+    blend(const DualQuaternion dqs[], const float weights[], size_t count);
+
+    /**
+     * @brief Batch skinning kernel: blends @p influences bones per vertex and
+     * transforms positions and normals.
+     *
+     * Bones are given as SoA real/dual parts, @p indices and @p weights are
+     * vertex-major (@p influences entries per vertex). The kernel has no
+     * per-vertex branches besides the antipodality sign, so the compiler can
+     * vectorise it. Vertices are independent, see the ParallelPool
+     * overload to split them between threads.
+     *
+     * @param realParts Bones' real parts (unit quaternions).
+     * @param dualParts Bones' dual parts.
+     * @param indices Bone index of each influence.
+     * @param weights Weight of each influence.
+     * @param influences Number of influences per vertex, 0 copies the rest
+     * pose.
+     * @param positions Rest positions.
+     * @param normals Rest normals, may be empty to skip normals.
+     * @param outPositions Skinned positions, same length as @p positions.
+     * @param outNormals Skinned normals, ignored if @p normals is empty.
+     */
+    static void skin(
+        const QuaternionArray& realParts,
+        const QuaternionArray& dualParts,
+        const uint16_t* indices,
+        const float* weights,
+        size_t influences,
+        const VectorArray& positions,
+        const VectorArray& normals,
+        VectorArray& outPositions,
+        VectorArray& outNormals);
+
+    /**
+     * @brief Batch skinning kernel on a ParallelPool: the vertex range is
+     * split into chunks (vertex arrays sliced, @p indices / @p weights
+     * offset by @f$first\cdot influences@f$), each skinned by the serial
+     * overload. The result matches the serial overload.
+     *
+     * @param pool Workers.
+     * @param realParts Bones' real parts (unit quaternions).
+     * @param dualParts Bones' dual parts.
+     * @param indices Bone index of each influence.
+     * @param weights Weight of each influence.
+     * @param influences Number of influences per vertex, 0 copies the rest
+     * pose.
+     * @param positions Rest positions.
+     * @param normals Rest normals, may be empty to skip normals.
+     * @param outPositions Skinned positions, same length as @p positions.
+     * @param outNormals Skinned normals, ignored if @p normals is empty.
+     */
+    static void skin(
+        ParallelPool& pool,
+        const QuaternionArray& realParts,
+        const QuaternionArray& dualParts,
+        const uint16_t* indices,
+        const float* weights,
+        size_t influences,
+        const VectorArray& positions,
+        const VectorArray& normals,
+        VectorArray& outPositions,
+        VectorArray& outNormals);
+
+    /**
+     * @brief Computes the norm of the real part.
+     *
+     * @return Norm.
+     */
+    float norm() const;
+
+    /**
+     * @brief Normalise the dual quaternion.
+     */
+    void normalise();
+
+    /**
+     * @brief Creates a normalised version of the dual quaternion.
+     *
+     * @return DualQuaternion
+     */
+    DualQuaternion normalised() const;
+
+    /**
+     * @brief Quaternion conjugate of both parts, the inverse of a unit dual
+     * quaternion.
+     *
+     * @return DualQuaternion
+     */
+    DualQuaternion conjugate() const;
+
+    /**
+     * @brief Extract the translation.
+     *
+     * @return Translation #Vector.
+     */
+    Vector translation() const;
+
+    /**
+     * @brief Applies rotation and translation to a point.
+     *
+     * @param p Point.
+     * @return Transformed point.
+     */
+    Vector transformPoint(const Vector& p) const;
+
+    /**
+     * @brief Applies the rotation only (directions, normals).
+     *
+     * @param v Direction.
+     * @return Rotated direction.
+     */
+    Vector transformVector(const Vector& v) const;
+
+    /**
+     * @brief Composition of transforms, @p rhs is applied first.
+     *
+     * @param rhs DualQuaternion.
+     * @return DualQuaternion
+     */
+    DualQuaternion operator*(const DualQuaternion& rhs) const;
+
+    /**
+     * @brief Elementwise multiplication by a scalar.
+     *
+     * @param n Multiplier.
+     * @return DualQuaternion
+     */
+    DualQuaternion operator*(float n) const;
+
+    /**
+     * @brief Addition with a dual quaternion.
+     *
+     * @param rhs DualQuaternion.
+     * @return DualQuaternion
+     */
+    DualQuaternion operator+(const DualQuaternion& rhs) const;
+
+    /**
+     * @brief Compound assignment addition with a dual quaternion.
+     *
+     * @param rhs DualQuaternion.
+     * @return DualQuaternion&
+     */
+    DualQuaternion& operator+=(const DualQuaternion& rhs);
+};
+
+#endif /* __LIB_CUSTOM_TYPE_DUALQUATERNION_H__ */
@@ -0,0 +1,155 @@
+/**
+ * @file eskf.cpp
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Error-state Kalman filter for attitude and gyro bias.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "eskf.h"
+#include "checkpoint.h"
+
+namespace {
+/**
+ * @brief Add @p v to the diagonal of @p m.
+ *
+ * @param m Matrix3x3, modified in place.
+ * @param v Value.
+ */
+void addDiagonal(Matrix3x3& m, float v) {
+    for (size_t i {}; i < MATRIX_ROWS; i++) {
+        m.set(i, m.coeff(i, i) + v);
+    }
+}
+
+/**
+ * @brief Symmetric part of @p m, removes round-off asymmetry.
+ *
+ * @param m Matrix3x3.
+ * @return Matrix3x3
+ */
+Matrix3x3 symmetrised(const Matrix3x3& m) {
+    return (m + m.transpose()) * 0.5f;
+}
+}  // namespace
+
+AttitudeESKF::AttitudeESKF(
+    float gyroDensity,
+    float biasDensity,
+    float angleStd,
+    float biasStd) :
+    attitude {},
+    gyroBias {},
+    gyroNoise { cst::sqr(gyroDensity) },
+    biasNoise { cst::sqr(biasDensity) } {
+    reset(Quaternion {}, Vector {}, angleStd, biasStd);
+}
+
+void AttitudeESKF::reset(
+    const Quaternion& q,
+    const Vector& b,
+    float angleStd,
+    float biasStd) {
+    attitude = q;
+    gyroBias = b;
+    pAA = Matrix3x3::identity() * cst::sqr(angleStd);
+    pAB = Matrix3x3 {};
+    pBB = Matrix3x3::identity() * cst::sqr(biasStd);
+}
+
+void AttitudeESKF::setNoise(float gyroDensity, float biasDensity) {
+    gyroNoise = cst::sqr(gyroDensity);
+    biasNoise = cst::sqr(biasDensity);
+}
+
+void AttitudeESKF::predict(const Vector& gyro, float dt) {
+    const Quaternion step {
+        Quaternion::fromRotationVector((gyro - gyroBias) * dt)
+    };
+    // error transition: A = exp(-phi), B = -dt I
+    const Matrix3x3 a { step.conjugate().toRotationMatrix() };
+    const Matrix3x3 m { a * pAB };
+
+    pAA = a * pAA * a.transpose() - (m + m.transpose()) * dt
+        + pBB * (dt * dt);
+    addDiagonal(pAA, gyroNoise * dt);
+    pAB = m - pBB * dt;
+    addDiagonal(pBB, biasNoise * dt);
+
+    attitude *= step;
+    attitude.normalize();
+}
+
+void AttitudeESKF::correct(
+    const Vector& measured,
+    const Vector& reference,
+    float noiseStd) {
+    const Vector z { measured.normalised() };
+    const Vector h { attitude.conjugate().rotate(reference.normalised()) };
+
+    // H = [h]x for the attitude block, zero for the bias block
+    const Matrix3x3 hSkew { Matrix3x3::skew(h) };
+    const Matrix3x3 hSkewT { hSkew.transpose() };
+    const Matrix3x3 phA { pAA * hSkewT };
+    const Matrix3x3 phB { pAB.transpose() * hSkewT };
+
+    Matrix3x3 s { hSkew * phA };
+    addDiagonal(s, cst::sqr(noiseStd));
+    const Matrix3x3 sInv { s.inverse() };
+
+    const Matrix3x3 kA { phA * sInv };
+    const Matrix3x3 kB { phB * sInv };
+    const Vector y { z - h };
+
+    // P -= K S K^T = (P H^T) K^T, symmetric by construction
+    pAA = symmetrised(pAA - phA * kA.transpose());
+    pAB -= phA * kB.transpose();
+    pBB = symmetrised(pBB - phB * kB.transpose());
+
+    attitude *= Quaternion::fromRotationVector(kA * y);
+    attitude.normalize();
+    gyroBias += kB * y;
+}
+
+Quaternion AttitudeESKF::orientation() const {
+    return attitude;
+}
+
+Vector AttitudeESKF::bias() const {
+    return gyroBias;
+}
+
+Matrix3x3 AttitudeESKF::attitudeCovariance() const {
+    return pAA;
+}
+
+Matrix3x3 AttitudeESKF::crossCovariance() const {
+    return pAB;
+}
+
+Matrix3x3 AttitudeESKF::biasCovariance() const {
+    return pBB;
+}
+
+AttitudeESKF::State AttitudeESKF::checkpoint() const {
+    State state;
+    cst::store(attitude, state.attitude);
+    cst::store(gyroBias, state.gyroBias);
+    cst::store(pAA, state.pAA);
+    cst::store(pAB, state.pAB);
+    cst::store(pBB, state.pBB);
+
+    return state;
+}
+
+void AttitudeESKF::restore(const State& state) {
+    attitude = cst::loadQuaternion(state.attitude);
+    gyroBias = cst::loadVector(state.gyroBias);
+    pAA = cst::loadMatrix(state.pAA);
+    pAB = cst::loadMatrix(state.pAB);
+    pBB = cst::loadMatrix(state.pBB);
+}
@@ -0,0 +1,339 @@
+/**
+ * @file filter.cpp
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief FIR and biquad IIR filters for 3-axis streams.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "filter.h"
+#include "checkpoint.h"
+
+FirFilter::FirFilter() : length { 0 }, pos { 0 } {
+    const float unit[1] { 1.0f };
+    setTaps(unit, 1);
+}
+
+bool FirFilter::setTaps(const float h[], size_t n) {
+    if (n == 0 || n > FIR_MAX_TAPS) {
+        return false;
+    }
+
+    for (size_t k {}; k < n; k++) {
+        taps[k] = h[k];
+    }
+    length = n;
+    reset();
+
+    return true;
+}
+
+bool FirFilter::lowPass(float cutoff, float rate, size_t n) {
+    if (n == 0 || n > FIR_MAX_TAPS) {
+        return false;
+    }
+
+    float h[FIR_MAX_TAPS];
+    const float fc { cutoff / rate };
+    const float mid { 0.5f * static_cast<float>(n - 1) };
+    float sum {};
+
+    for (size_t k {}; k < n; k++) {
+        const float t { static_cast<float>(k) - mid };
+        const float sinc {
+            t == 0.0f ? 2.0f * fc
+                      : sinf(2.0f * cst::PI * fc * t) / (cst::PI * t)
+        };
+        const float window {
+            n > 1 ? 0.54f
+                    - 0.46f
+                        * cosf(
+                            2.0f * cst::PI * static_cast<float>(k)
+                            / static_cast<float>(n - 1))
+                  : 1.0f
+        };
+        h[k] = sinc * window;
+        sum += h[k];
+    }
+    for (size_t k {}; k < n; k++) {
+        h[k] /= sum;
+    }
+
+    return setTaps(h, n);
+}
+
+size_t FirFilter::size() const {
+    return length;
+}
+
+void FirFilter::reset() {
+    for (size_t a {}; a < 3; a++) {
+        for (size_t k {}; k < 2 * FIR_MAX_TAPS; k++) {
+            delay[a][k] = 0.0f;
+        }
+    }
+    pos = 0;
+}
+
+Vector FirFilter::update(const Vector& in) {
+    // newest first; each sample is written twice so that the taps always
+    // read delay[pos .. pos + length)
+    pos = pos == 0 ? length - 1 : pos - 1;
+    delay[0][pos] = delay[0][pos + length] = in.x;
+    delay[1][pos] = delay[1][pos + length] = in.y;
+    delay[2][pos] = delay[2][pos + length] = in.z;
+
+    const float* dx { delay[0] + pos };
+    const float* dy { delay[1] + pos };
+    const float* dz { delay[2] + pos };
+    float x {};
+    float y {};
+    float z {};
+    for (size_t k {}; k < length; k++) {
+        x += taps[k] * dx[k];
+        y += taps[k] * dy[k];
+        z += taps[k] * dz[k];
+    }
+
+    return Vector { x, y, z };
+}
+
+void FirFilter::process(const VectorArray& in, VectorArray& out) {
+    const size_t n { in.length };
+    const size_t past { length - 1 };
+    const float* const src[3] { in.x, in.y, in.z };
+    float* const dst[3] { out.x, out.y, out.z };
+
+    for (size_t start {}; start < n; start += FILTER_BLOCK) {
+        const size_t len {
+            n - start < FILTER_BLOCK ? n - start : FILTER_BLOCK
+        };
+
+        for (size_t a {}; a < 3; a++) {
+            // oldest first: the last length - 1 samples, then the block
+            float buf[FIR_MAX_TAPS - 1 + FILTER_BLOCK];
+            float acc[FILTER_BLOCK];
+            for (size_t j {}; j < past; j++) {
+                buf[j] = delay[a][pos + past - 1 - j];
+            }
+            for (size_t i {}; i < FILTER_BLOCK; i++) {
+                buf[past + i] = i < len ? src[a][start + i] : 0.0f;
+                acc[i] = 0.0f;
+            }
+
+            // one tap over the whole (padded) block at a time: a fixed trip
+            // count that vectorises along time
+            for (size_t k {}; k < length; k++) {
+                const float h { taps[k] };
+                const float* CST_RESTRICT b { buf + past - k };
+                float* CST_RESTRICT y { acc };
+                CST_IVDEP
+                for (size_t i {}; i < FILTER_BLOCK; i++) {
+                    y[i] += h * b[i];
+                }
+            }
+
+            for (size_t i {}; i < len; i++) {
+                dst[a][start + i] = acc[i];
+            }
+            // the delay line holds the last length samples, newest first
+            for (size_t k {}; k < length; k++) {
+                delay[a][k] = delay[a][k + length] = buf[past + len - 1 - k];
+            }
+        }
+        pos = 0;
+    }
+}
+
+Biquad::Biquad(float nb0, float nb1, float nb2, float na1, float na2) :
+    b0 { nb0 },
+    b1 { nb1 },
+    b2 { nb2 },
+    a1 { na1 },
+    a2 { na2 } {}
+
+Biquad Biquad::lowPass(float cutoff, float rate, float q) {
+    const float w { 2.0f * cst::PI * cutoff / rate };
+    const float c { cosf(w) };
+    const float alpha { sinf(w) / (2.0f * q) };
+    const float inv { 1.0f / (1.0f + alpha) };
+
+    return Biquad {
+        0.5f * (1.0f - c) * inv,
+        (1.0f - c) * inv,
+        0.5f * (1.0f - c) * inv,
+        -2.0f * c * inv,
+        (1.0f - alpha) * inv,
+    };
+}
+
+Biquad Biquad::highPass(float cutoff, float rate, float q) {
+    const float w { 2.0f * cst::PI * cutoff / rate };
+    const float c { cosf(w) };
+    const float alpha { sinf(w) / (2.0f * q) };
+    const float inv { 1.0f / (1.0f + alpha) };
+
+    return Biquad {
+        0.5f * (1.0f + c) * inv,
+        -(1.0f + c) * inv,
+        0.5f * (1.0f + c) * inv,
+        -2.0f * c * inv,
+        (1.0f - alpha) * inv,
+    };
+}
+
+Biquad Biquad::notch(float centre, float rate, float q) {
+    const float w { 2.0f * cst::PI * centre / rate };
+    const float c { cosf(w) };
+    const float alpha { sinf(w) / (2.0f * q) };
+    const float inv { 1.0f / (1.0f + alpha) };
+
+    return Biquad {
+        inv,
+        -2.0f * c * inv,
+        inv,
+        -2.0f * c * inv,
+        (1.0f - alpha) * inv,
+    };
+}
+
+BiquadCascade::BiquadCascade() : count { 0 } {
+    reset();
+}
+
+bool BiquadCascade::addSection(const Biquad& s) {
+    if (count == BIQUAD_MAX_SECTIONS) {
+        return false;
+    }
+
+    sections[count] = s;
+    for (size_t a {}; a < 3; a++) {
+        z1[count][a] = 0.0f;
+        z2[count][a] = 0.0f;
+    }
+    count++;
+
+    return true;
+}
+
+void BiquadCascade::clear() {
+    count = 0;
+}
+
+size_t BiquadCascade::size() const {
+    return count;
+}
+
+void BiquadCascade::reset() {
+    for (size_t s {}; s < BIQUAD_MAX_SECTIONS; s++) {
+        for (size_t a {}; a < 3; a++) {
+            z1[s][a] = 0.0f;
+            z2[s][a] = 0.0f;
+        }
+    }
+}
+
+Vector BiquadCascade::update(const Vector& in) {
+    float v[3] { in.x, in.y, in.z };
+
+    for (size_t s {}; s < count; s++) {
+        const Biquad& c { sections[s] };
+        for (size_t a {}; a < 3; a++) {
+            const float y { c.b0 * v[a] + z1[s][a] };
+            z1[s][a] = c.b1 * v[a] - c.a1 * y + z2[s][a];
+            z2[s][a] = c.b2 * v[a] - c.a2 * y;
+            v[a] = y;
+        }
+    }
+
+    return Vector { v[0], v[1], v[2] };
+}
+
+void BiquadCascade::process(const VectorArray& in, VectorArray& out) {
+    const size_t n { in.length };
+
+    if (count == 0) {
+        for (size_t i {}; i < n; i++) {
+            out.x[i] = in.x[i];
+            out.y[i] = in.y[i];
+            out.z[i] = in.z[i];
+        }
+        return;
+    }
+
+    for (size_t s {}; s < count; s++) {
+        // the first section reads the input, the others filter in place
+        const float* xs { s == 0 ? in.x : out.x };
+        const float* ys { s == 0 ? in.y : out.y };
+        const float* zs { s == 0 ? in.z : out.z };
+        float* ox { out.x };
+        float* oy { out.y };
+        float* oz { out.z };
+        const float b0 { sections[s].b0 };
+        const float b1 { sections[s].b1 };
+        const float b2 { sections[s].b2 };
+        const float a1 { sections[s].a1 };
+        const float a2 { sections[s].a2 };
+        float sx1 { z1[s][0] };
+        float sy1 { z1[s][1] };
+        float sz1 { z1[s][2] };
+        float sx2 { z2[s][0] };
+        float sy2 { z2[s][1] };
+        float sz2 { z2[s][2] };
+
+        for (size_t i {}; i < n; i++) {
+            const float x { xs[i] };
+            const float y { ys[i] };
+            const float z { zs[i] };
+            const float fx { b0 * x + sx1 };
+            const float fy { b0 * y + sy1 };
+            const float fz { b0 * z + sz1 };
+            sx1 = b1 * x - a1 * fx + sx2;
+            sy1 = b1 * y - a1 * fy + sy2;
+            sz1 = b1 * z - a1 * fz + sz2;
+            sx2 = b2 * x - a2 * fx;
+            sy2 = b2 * y - a2 * fy;
+            sz2 = b2 * z - a2 * fz;
+            ox[i] = fx;
+            oy[i] = fy;
+            oz[i] = fz;
+        }
+
+        z1[s][0] = sx1;
+        z1[s][1] = sy1;
+        z1[s][2] = sz1;
+        z2[s][0] = sx2;
+        z2[s][1] = sy2;
+        z2[s][2] = sz2;
+    }
+}
+
+FirFilter::State FirFilter::checkpoint() const {
+    State state;
+    memcpy(state.delay, delay, sizeof(delay));
+    state.pos = static_cast<uint32_t>(pos);
+
+    return state;
+}
+
+void FirFilter::restore(const State& state) {
+    memcpy(delay, state.delay, sizeof(delay));
+    pos = state.pos;
+}
+
+BiquadCascade::State BiquadCascade::checkpoint() const {
+    State state;
+    memcpy(state.z1, z1, sizeof(z1));
+    memcpy(state.z2, z2, sizeof(z2));
+
+    return state;
+}
+
+void BiquadCascade::restore(const State& state) {
+    memcpy(z1, state.z1, sizeof(z1));
+    memcpy(z2, state.z2, sizeof(z2));
+}
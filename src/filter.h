@@ -0,0 +1,339 @@
+/**
+ * @file filter.h
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief FIR and biquad IIR filters for 3-axis streams.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef __LIB_CUSTOM_TYPE_FILTER_H__
+#define __LIB_CUSTOM_TYPE_FILTER_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "def.h"
+#include "vector.h"
+#include "arrays.h"
+
+/**
+ * @brief Maximum number of FIR taps.
+ */
+const size_t FIR_MAX_TAPS { 64 };
+
+/**
+ * @brief Maximum number of biquad sections in a cascade.
+ */
+const size_t BIQUAD_MAX_SECTIONS { 8 };
+
+/**
+ * @brief Samples per block in the batch FIR.
+ */
+const size_t FILTER_BLOCK { 64 };
+
+/**
+ * @brief Checkpoint of a FirFilter (configuration excluded).
+ */
+struct FirState {
+    /**
+     * @brief Doubled delay lines (x, y, z).
+     */
+    float delay[3][2 * FIR_MAX_TAPS];
+    /**
+     * @brief Position of the newest sample in the delay lines.
+     */
+    uint32_t pos;
+};
+
+/**
+ * @class FirFilter
+ * @brief FIR filter applied to each axis of a Vector stream.
+ *
+ * The per-sample path keeps a doubled delay line per axis, so the
+ * convolution always reads contiguous memory (no modulo). The batch path
+ * works on blocks of #FILTER_BLOCK samples and accumulates one tap at a
+ * time over the whole block, which vectorises along time.
+ */
+class FirFilter {
+  private:
+    /**
+     * @brief Coefficients, @f$h_0@f$ applies to the newest sample.
+     */
+    float taps[FIR_MAX_TAPS];
+    /**
+     * @brief Number of taps.
+     */
+    size_t length;
+    /**
+     * @brief Doubled delay lines (x, y, z), newest sample at #pos.
+     */
+    float delay[3][2 * FIR_MAX_TAPS];
+    /**
+     * @brief Position of the newest sample in the delay lines.
+     */
+    size_t pos;
+
+  public:
+    /**
+     * @brief Checkpoint type.
+     */
+    typedef FirState State;
+
+    /**
+     * @brief Construct a pass-through FirFilter object (one unit tap).
+     */
+    FirFilter();
+
+    /**
+     * @brief Set the coefficients and reset the delay lines.
+     *
+     * @param h Coefficients, @p h[0] applies to the newest sample.
+     * @param n Number of coefficients, at most #FIR_MAX_TAPS.
+     * @return false if @p n is 0 or too large (nothing changes).
+     */
+    bool setTaps(const float h[], size_t n);
+
+    /**
+     * @brief Windowed-sinc (Hamming) low-pass design, unit DC gain.
+     *
+     * @param cutoff Cut-off frequency (Hz).
+     * @param rate Sample rate (Hz).
+     * @param n Number of taps, at most #FIR_MAX_TAPS (odd for a type I
+     * filter).
+     * @return false if @p n is 0 or too large.
+     */
+    bool lowPass(float cutoff, float rate, size_t n);
+
+    /**
+     * @brief Number of taps.
+     *
+     * @return size_t
+     */
+    size_t size() const;
+
+    /**
+     * @brief Clear the delay lines.
+     */
+    void reset();
+
+    /**
+     * @brief Filter one sample.
+     *
+     * @param in Sample.
+     * @return Filtered sample.
+     */
+    Vector update(const Vector& in);
+
+    /**
+     * @brief Filter samples, continuing from the current state.
+     *
+     * @param in Samples.
+     * @param out Filtered samples, same length as @p in, may be @p in.
+     */
+    void process(const VectorArray& in, VectorArray& out);
+
+    /**
+     * @brief Snapshot of the filter state.
+     *
+     * @return State
+     */
+    State checkpoint() const;
+
+    /**
+     * @brief Resume from a snapshot; the configuration is kept.
+     *
+     * @param state State.
+     */
+    void restore(const State& state);
+};
+
+/**
+ * @class Biquad
+ * @brief Second order section coefficients, @f$a_0@f$ normalised to 1:
+ * @f$H(z)=\frac{b_0+b_1z^{-1}+b_2z^{-2}}{1+a_1z^{-1}+a_2z^{-2}}@f$.
+ *
+ * The designs follow the RBJ audio EQ cookbook.
+ */
+class Biquad {
+  public:
+    /**
+     * @brief Feed-forward coefficient of the current input.
+     */
+    float b0;
+    /**
+     * @brief Feed-forward coefficient of the previous input.
+     */
+    float b1;
+    /**
+     * @brief Feed-forward coefficient of the input before.
+     */
+    float b2;
+    /**
+     * @brief Feedback coefficient of the previous output.
+     */
+    float a1;
+    /**
+     * @brief Feedback coefficient of the output before.
+     */
+    float a2;
+
+    /**
+     * @brief Construct a new Biquad object, pass-through by default.
+     *
+     * @param nb0 @f$b_0@f$.
+     * @param nb1 @f$b_1@f$.
+     * @param nb2 @f$b_2@f$.
+     * @param na1 @f$a_1@f$.
+     * @param na2 @f$a_2@f$.
+     */
+    explicit Biquad(
+        float nb0 = 1.0f,
+        float nb1 = 0.0f,
+        float nb2 = 0.0f,
+        float na1 = 0.0f,
+        float na2 = 0.0f);
+
+    /**
+     * @brief Second order low-pass.
+     *
+     * @param cutoff Cut-off frequency (Hz).
+     * @param rate Sample rate (Hz).
+     * @param q Quality factor, 0.7071 for Butterworth.
+     * @return Biquad
+     */
+    static Biquad lowPass(float cutoff, float rate, float q = 0.70710678f);
+
+    /**
+     * @brief Second order high-pass.
+     *
+     * @param cutoff Cut-off frequency (Hz).
+     * @param rate Sample rate (Hz).
+     * @param q Quality factor, 0.7071 for Butterworth.
+     * @return Biquad
+     */
+    static Biquad highPass(float cutoff, float rate, float q = 0.70710678f);
+
+    /**
+     * @brief Notch.
+     *
+     * @param centre Rejected frequency (Hz).
+     * @param rate Sample rate (Hz).
+     * @param q Quality factor, centre / bandwidth.
+     * @return Biquad
+     */
+    static Biquad notch(float centre, float rate, float q);
+};
+
+/**
+ * @brief Checkpoint of a BiquadCascade (configuration excluded).
+ */
+struct BiquadState {
+    /**
+     * @brief First state of each section (x, y, z).
+     */
+    float z1[BIQUAD_MAX_SECTIONS][3];
+    /**
+     * @brief Second state of each section (x, y, z).
+     */
+    float z2[BIQUAD_MAX_SECTIONS][3];
+};
+
+/**
+ * @class BiquadCascade
+ * @brief Cascade of biquad sections applied to each axis of a Vector
+ * stream, transposed direct form II.
+ *
+ * The recursion is serial in time, so the batch path runs one section at a
+ * time over the whole block (coefficients stay in registers) and advances
+ * the three axes together as independent chains.
+ */
+class BiquadCascade {
+  private:
+    /**
+     * @brief Sections.
+     */
+    Biquad sections[BIQUAD_MAX_SECTIONS];
+    /**
+     * @brief Number of sections.
+     */
+    size_t count;
+    /**
+     * @brief First state of each section (x, y, z).
+     */
+    float z1[BIQUAD_MAX_SECTIONS][3];
+    /**
+     * @brief Second state of each section (x, y, z).
+     */
+    float z2[BIQUAD_MAX_SECTIONS][3];
+
+  public:
+    /**
+     * @brief Checkpoint type.
+     */
+    typedef BiquadState State;
+
+    /**
+     * @brief Construct an empty (pass-through) BiquadCascade object.
+     */
+    BiquadCascade();
+
+    /**
+     * @brief Append a section, its state starts at 0.
+     *
+     * @param s Section.
+     * @return false if the cascade is full.
+     */
+    bool addSection(const Biquad& s);
+
+    /**
+     * @brief Remove all sections.
+     */
+    void clear();
+
+    /**
+     * @brief Number of sections.
+     *
+     * @return size_t
+     */
+    size_t size() const;
+
+    /**
+     * @brief Clear the states.
+     */
+    void reset();
+
+    /**
+     * @brief Filter one sample.
+     *
+     * @param in Sample.
+     * @return Filtered sample.
+     */
+    Vector update(const Vector& in);
+
+    /**
+     * @brief Filter samples, continuing from the current state.
+     *
+     * @param in Samples.
+     * @param out Filtered samples, same length as @p in, may be @p in.
+     */
+    void process(const VectorArray& in, VectorArray& out);
+
+    /**
+     * @brief Snapshot of the filter state.
+     *
+     * @return State
+     */
+    State checkpoint() const;
+
+    /**
+     * @brief Resume from a snapshot; the configuration is kept.
+     *
+     * @param state State.
+     */
+    void restore(const State& state);
+};
+
+#endif /* __LIB_CUSTOM_TYPE_FILTER_H__ */
@@ -0,0 +1,165 @@
+/**
+ * @file gravity.cpp
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Gravity removal and tilt-compensated heading.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "gravity.h"
+
+namespace {
+/**
+ * @brief Linear accelerations of @p n samples. A constant @p n gives a
+ * vectorised loop.
+ *
+ * @param qs Attitudes.
+ * @param accels Specific forces.
+ * @param out Linear accelerations.
+ * @param g Gravity magnitude.
+ * @param offset First sample.
+ * @param n Number of samples.
+ */
+inline void linearBlock(
+    const QuaternionArray& qs,
+    const VectorArray& accels,
+    VectorArray& out,
+    float g,
+    size_t offset,
+    size_t n) {
+    const float* CST_RESTRICT ws { qs.w + offset };
+    const float* CST_RESTRICT xs { qs.x + offset };
+    const float* CST_RESTRICT ys { qs.y + offset };
+    const float* CST_RESTRICT zs { qs.z + offset };
+    const float* ax { accels.x + offset };
+    const float* ay { accels.y + offset };
+    const float* az { accels.z + offset };
+    float* ox { out.x + offset };
+    float* oy { out.y + offset };
+    float* oz { out.z + offset };
+    const float g2 { 2.0f * g };
+
+    // each element is read before it is written, in place is fine
+    CST_IVDEP
+    for (size_t i {}; i < n; i++) {
+        const float w { ws[i] };
+        const float x { xs[i] };
+        const float y { ys[i] };
+        const float z { zs[i] };
+        ox[i] = ax[i] + g2 * (x * z - w * y);
+        oy[i] = ay[i] + g2 * (y * z + w * x);
+        oz[i] = az[i] + g - g2 * (x * x + y * y);
+    }
+}
+
+/**
+ * @brief North and east components of the body x-axis, up to a positive
+ * factor, for @p n samples. A constant @p n gives a vectorised loop.
+ *
+ * @param qs Attitudes.
+ * @param mags Magnetic fields.
+ * @param offset First sample.
+ * @param north North components, @p n of them.
+ * @param east East components, @p n of them.
+ * @param n Number of samples.
+ */
+inline void horizontalBlock(
+    const QuaternionArray& qs,
+    const VectorArray& mags,
+    size_t offset,
+    float* CST_RESTRICT north,
+    float* CST_RESTRICT east,
+    size_t n) {
+    const float* CST_RESTRICT ws { qs.w + offset };
+    const float* CST_RESTRICT xs { qs.x + offset };
+    const float* CST_RESTRICT ys { qs.y + offset };
+    const float* CST_RESTRICT zs { qs.z + offset };
+    const float* CST_RESTRICT mx { mags.x + offset };
+    const float* CST_RESTRICT my { mags.y + offset };
+    const float* CST_RESTRICT mz { mags.z + offset };
+
+    CST_IVDEP
+    for (size_t i {}; i < n; i++) {
+        const float w { ws[i] };
+        const float x { xs[i] };
+        const float y { ys[i] };
+        const float z { zs[i] };
+        const float dx { 2.0f * (x * z - w * y) };
+        const float dy { 2.0f * (y * z + w * x) };
+        const float dz { 1.0f - 2.0f * (x * x + y * y) };
+        // E = d x m, N = E x d
+        const float ex { dy * mz[i] - dz * my[i] };
+        const float ey { dz * mx[i] - dx * mz[i] };
+        const float ez { dx * my[i] - dy * mx[i] };
+        east[i] = ex;
+        north[i] = ey * dz - ez * dy;
+    }
+}
+}  // namespace
+
+Vector GravityRemoval::down(const Quaternion& q) {
+    return Vector {
+        2.0f * (q.x * q.z - q.w * q.y),
+        2.0f * (q.y * q.z + q.w * q.x),
+        1.0f - 2.0f * (q.x * q.x + q.y * q.y),
+    };
+}
+
+Vector GravityRemoval::linear(
+    const Quaternion& q,
+    const Vector& accel,
+    float g) {
+    const Vector d { down(q) };
+
+    return Vector {
+        accel.x + g * d.x,
+        accel.y + g * d.y,
+        accel.z + g * d.z,
+    };
+}
+
+void GravityRemoval::linear(
+    const QuaternionArray& qs,
+    const VectorArray& accels,
+    VectorArray& out,
+    float g) {
+    const size_t n { qs.length };
+    size_t i {};
+
+    for (; i + GRAVITY_BLOCK <= n; i += GRAVITY_BLOCK) {
+        linearBlock(qs, accels, out, g, i, GRAVITY_BLOCK);
+    }
+    linearBlock(qs, accels, out, g, i, n - i);
+}
+
+float GravityRemoval::heading(const Quaternion& q, const Vector& mag) {
+    const Vector d { down(q) };
+    const Vector e { d.cross(mag) };
+
+    return atan2f(e.x, e.y * d.z - e.z * d.y);
+}
+
+void GravityRemoval::heading(
+    const QuaternionArray& qs,
+    const VectorArray& mags,
+    float* out) {
+    const size_t n { qs.length };
+    float north[GRAVITY_BLOCK];
+    float east[GRAVITY_BLOCK];
+
+    for (size_t i {}; i < n; i += GRAVITY_BLOCK) {
+        const size_t len { n - i < GRAVITY_BLOCK ? n - i : GRAVITY_BLOCK };
+        if (len == GRAVITY_BLOCK) {
+            horizontalBlock(qs, mags, i, north, east, GRAVITY_BLOCK);
+        } else {
+            horizontalBlock(qs, mags, i, north, east, len);
+        }
+        for (size_t k {}; k < len; k++) {
+            out[i + k] = atan2f(east[k], north[k]);
+        }
+    }
+}
@@ -0,0 +1,100 @@
+/**
+ * @file gravity.h
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Gravity removal and tilt-compensated heading.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef __LIB_CUSTOM_TYPE_GRAVITY_H__
+#define __LIB_CUSTOM_TYPE_GRAVITY_H__
+
+#include <stddef.h>
+#include "def.h"
+#include "vector.h"
+#include "quaternion.h"
+#include "arrays.h"
+
+/**
+ * @brief Samples per block in the #GravityRemoval batch kernels (constant
+ * trip count).
+ */
+const size_t GRAVITY_BLOCK { 32 };
+
+/**
+ * @class GravityRemoval
+ * @brief Linear acceleration and heading from an attitude, NED frame.
+ *
+ * Only the third row of the rotation matrix is needed: the body-frame down
+ * direction @f$d=R^T(0,0,1)^T@f$, six products of the quaternion
+ * components. At rest the accelerometer reads @f$-g\,d@f$, so the linear
+ * acceleration is @f$f+g\,d@f$.
+ *
+ * The heading is the angle of the body x-axis from the horizontal part of
+ * the magnetic field, clockwise seen from above (NED yaw), using only the
+ * tilt of the attitude. Add the declination for a true heading.
+ */
+class GravityRemoval {
+  public:
+    /**
+     * @brief Body-frame down direction.
+     *
+     * @param q Unit quaternion (body to nav).
+     * @return Unit Vector.
+     */
+    static Vector down(const Quaternion& q);
+
+    /**
+     * @brief Linear acceleration.
+     *
+     * @param q Unit quaternion (body to nav).
+     * @param accel Specific force (m/s^2), body frame.
+     * @param g Gravity magnitude.
+     * @return Body-frame linear acceleration.
+     */
+    static Vector linear(
+        const Quaternion& q,
+        const Vector& accel,
+        float g = 9.80665f);
+
+    /**
+     * @brief Linear accelerations of a recorded log.
+     *
+     * @param qs Unit quaternions (body to nav).
+     * @param accels Specific forces (m/s^2), same length as @p qs.
+     * @param out Linear accelerations, same length, may be @p accels.
+     * @param g Gravity magnitude.
+     */
+    static void linear(
+        const QuaternionArray& qs,
+        const VectorArray& accels,
+        VectorArray& out,
+        float g = 9.80665f);
+
+    /**
+     * @brief Tilt-compensated magnetic heading.
+     *
+     * @param q Unit quaternion (body to nav), its yaw is not used.
+     * @param mag Magnetic field, body frame.
+     * @return Heading in @f$[-\pi,\pi]@f$ (radians).
+     */
+    static float heading(const Quaternion& q, const Vector& mag);
+
+    /**
+     * @brief Tilt-compensated magnetic headings of a recorded log.
+     *
+     * @param qs Unit quaternions (body to nav).
+     * @param mags Magnetic fields, same length as @p qs.
+     * @param out Headings (radians), @p qs.length of them.
+     */
+    static void heading(
+        const QuaternionArray& qs,
+        const VectorArray& mags,
+        float* out);
+};
+
+#endif /* __LIB_CUSTOM_TYPE_GRAVITY_H__ */
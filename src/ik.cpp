@@ -0,0 +1,268 @@
+/**
+ * @file ik.cpp
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief CCD and FABRIK inverse kinematics on a #KinematicTree.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "ik.h"
+
+namespace {
+/**
+ * @brief Unit direction of @p v, or @p fallback if @p v is (nearly) zero.
+ *
+ * @param v #Vector.
+ * @param fallback Returned for degenerate input.
+ * @return Vector
+ */
+Vector direction(const Vector& v, const Vector& fallback) {
+    const float n2 { v.normSqr() };
+    if (n2 < cst::EPSILON) {
+        return fallback;
+    }
+
+    return v / sqrtf(n2);
+}
+
+/**
+ * @brief Clamp the rotation angle of unit @p q to @f$2\arccos(c)@f$.
+ *
+ * @param q Unit quaternion, modified in place.
+ * @param c Cosine of the maximum half angle.
+ */
+void clampAngle(Quaternion& q, float c) {
+    if (q.w < 0.0f) {
+        q = -q;
+    }
+    if (q.w >= c) {
+        return;
+    }
+
+    const float s2 { cst::sqr(q.x) + cst::sqr(q.y) + cst::sqr(q.z) };
+    if (s2 < cst::EPSILON) {
+        return;
+    }
+
+    const float k { sqrtf((1.0f - cst::sqr(c)) / s2) };
+    q = Quaternion { c, q.x * k, q.y * k, q.z * k };
+}
+}  // namespace
+
+IKResult::IKResult(size_t n, float e, bool c) :
+    iterations { n },
+    error { e },
+    converged { c } {}
+
+IKSolver::IKSolver(size_t iterations, float tol) :
+    chain {},
+    length { 0 },
+    limited {},
+    cosHalfSwing {},
+    cosHalfTwist {},
+    lengths {},
+    maxIterations { iterations },
+    tolerance { tol } {}
+
+bool IKSolver::setChain(
+    const KinematicTree& tree,
+    size_t root,
+    size_t effector) {
+    length = 0;
+    if (root >= tree.size() || effector >= tree.size() || root == effector) {
+        return false;
+    }
+
+    // walk up from the effector, then reverse
+    size_t n {};
+    size_t seg { effector };
+    while (seg != KINEMATIC_NONE) {
+        chain[n++] = seg;
+        if (seg == root) {
+            break;
+        }
+        seg = tree.parent(seg);
+    }
+
+    if (seg != root) {
+        return false;
+    }
+
+    for (size_t i {}; i < n / 2; i++) {
+        const size_t tmp { chain[i] };
+        chain[i] = chain[n - 1 - i];
+        chain[n - 1 - i] = tmp;
+    }
+    length = n;
+
+    return true;
+}
+
+size_t IKSolver::chainLength() const {
+    return length;
+}
+
+void IKSolver::setJointLimit(
+    size_t seg,
+    const Vector& twistAxis,
+    float maxSwing,
+    float maxTwist) {
+    limited[seg] = true;
+    twistAxes[seg] = twistAxis.normalised();
+    // trig is paid once here, never while solving
+    cosHalfSwing[seg] = cosf(0.5f * maxSwing);
+    cosHalfTwist[seg] = cosf(0.5f * maxTwist);
+}
+
+void IKSolver::clearJointLimit(size_t seg) {
+    limited[seg] = false;
+}
+
+void IKSolver::setMaxIterations(size_t iterations) {
+    maxIterations = iterations;
+}
+
+void IKSolver::setTolerance(float tol) {
+    tolerance = tol;
+}
+
+Quaternion IKSolver::constrain(size_t seg, const Quaternion& q) const {
+    if (!limited[seg]) {
+        return q;
+    }
+
+    Quaternion swing;
+    Quaternion twist;
+    q.swingTwist(twistAxes[seg], swing, twist);
+    clampAngle(swing, cosHalfSwing[seg]);
+    clampAngle(twist, cosHalfTwist[seg]);
+
+    return swing * twist;
+}
+
+void IKSolver::rotateJoint(
+    KinematicTree& tree,
+    size_t seg,
+    const Quaternion& delta) const {
+    // local' = parent^-1 * delta * world
+    Quaternion local { delta * tree.worldRotation(seg) };
+    const size_t p { tree.parent(seg) };
+    if (p != KINEMATIC_NONE) {
+        local = tree.worldRotation(p).conjugate() * local;
+    }
+    local.normalize();
+
+    tree.setLocalRotation(seg, constrain(seg, local));
+}
+
+IKResult IKSolver::solveCCD(KinematicTree& tree, const Vector& target) {
+    if (length < 2) {
+        return IKResult {};
+    }
+
+    tree.update();
+    const size_t effector { chain[length - 1] };
+    float error { (tree.worldPosition(effector) - target).norm() };
+    size_t it {};
+
+    for (; it < maxIterations && error > tolerance; it++) {
+        for (size_t j { length - 1 }; j-- > 0;) {
+            const size_t seg { chain[j] };
+            const Vector pivot { tree.worldPosition(seg) };
+            const Vector toEffector { tree.worldPosition(effector) - pivot };
+            const Vector toTarget { target - pivot };
+
+            if (toEffector.normSqr() < cst::EPSILON
+                || toTarget.normSqr() < cst::EPSILON) {
+                continue;
+            }
+
+            rotateJoint(
+                tree,
+                seg,
+                Quaternion::fromTwoVectors(toEffector, toTarget));
+            // only the subtree below seg is recomputed
+            tree.update();
+        }
+
+        error = (tree.worldPosition(effector) - target).norm();
+    }
+
+    return IKResult { it, error, error <= tolerance };
+}
+
+IKResult IKSolver::solveFABRIK(KinematicTree& tree, const Vector& target) {
+    if (length < 2) {
+        return IKResult {};
+    }
+
+    tree.update();
+    const size_t last { length - 1 };
+    float total {};
+
+    for (size_t i {}; i < length; i++) {
+        points[i] = tree.worldPosition(chain[i]);
+        if (i < last) {
+            lengths[i] = tree.offset(chain[i + 1]).norm();
+            total += lengths[i];
+        }
+    }
+
+    const Vector origin { points[0] };
+    const Vector fallback {
+        direction(points[last] - origin, Vector { 1.0f, 0.0f, 0.0f })
+    };
+    float error { (points[last] - target).norm() };
+    size_t it {};
+
+    if ((target - origin).norm() >= total) {
+        // out of reach: stretch towards the target
+        const Vector dir { direction(target - origin, fallback) };
+        for (size_t i {}; i < last; i++) {
+            points[i + 1] = points[i] + dir * lengths[i];
+        }
+        it = 1;
+    } else {
+        for (; it < maxIterations && error > tolerance; it++) {
+            points[last] = target;
+            for (size_t i { last }; i-- > 0;) {
+                const Vector dir {
+                    direction(points[i] - points[i + 1], -fallback)
+                };
+                points[i] = points[i + 1] + dir * lengths[i];
+            }
+
+            points[0] = origin;
+            for (size_t i {}; i < last; i++) {
+                const Vector dir {
+                    direction(points[i + 1] - points[i], fallback)
+                };
+                points[i + 1] = points[i] + dir * lengths[i];
+            }
+
+            error = (points[last] - target).norm();
+        }
+    }
+
+    // back to rotations, root first so each joint sees its final parent
+    for (size_t j {}; j < last; j++) {
+        const size_t seg { chain[j] };
+        const Vector pivot { tree.worldPosition(seg) };
+        const Vector current { tree.worldPosition(chain[j + 1]) - pivot };
+        const Vector wanted { points[j + 1] - points[j] };
+
+        if (current.normSqr() >= cst::EPSILON
+            && wanted.normSqr() >= cst::EPSILON) {
+            rotateJoint(tree, seg, Quaternion::fromTwoVectors(current, wanted));
+        }
+        tree.update();
+    }
+
+    error = (tree.worldPosition(chain[last]) - target).norm();
+
+    return IKResult { it, error, error <= tolerance };
+}
@@ -0,0 +1,218 @@
+/**
+ * @file ik.h
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief CCD and FABRIK inverse kinematics on a #KinematicTree.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef __LIB_CUSTOM_TYPE_IK_H__
+#define __LIB_CUSTOM_TYPE_IK_H__
+
+#include <stddef.h>
+#include "def.h"
+#include "vector.h"
+#include "quaternion.h"
+#include "kinematics.h"
+
+/**
+ * @class IKResult
+ * @brief Outcome of a solve, for latency budgeting.
+ */
+class IKResult {
+  public:
+    /**
+     * @brief Iterations performed.
+     */
+    size_t iterations;
+    /**
+     * @brief Distance between the end effector and the target.
+     */
+    float error;
+    /**
+     * @brief Whether @p error reached the solver's tolerance.
+     */
+    bool converged;
+
+    /**
+     * @brief Construct a new IKResult object.
+     *
+     * @param n Iterations performed.
+     * @param e Final error.
+     * @param c Convergence flag.
+     */
+    explicit IKResult(size_t n = 0, float e = 0.0f, bool c = false);
+};
+
+/**
+ * @class IKSolver
+ * @brief Allocation-free inverse kinematics on a chain of a #KinematicTree.
+ *
+ * Rotations are updated with #Quaternion::fromTwoVectors, no trigonometric
+ * function is evaluated while solving. Joint limits are enforced on the
+ * local rotations through a swing-twist split about a per-joint axis.
+ */
+class IKSolver {
+  private:
+    /**
+     * @brief Chain segments, from the first joint to the end effector.
+     */
+    size_t chain[KINEMATIC_MAX_SEGMENTS];
+
+    /**
+     * @brief Number of segments in #chain.
+     */
+    size_t length;
+
+    /**
+     * @brief Segments with a joint limit.
+     */
+    bool limited[KINEMATIC_MAX_SEGMENTS];
+
+    /**
+     * @brief Twist axis of each limited joint, in the joint's local frame.
+     */
+    Vector twistAxes[KINEMATIC_MAX_SEGMENTS];
+
+    /**
+     * @brief Cosine of half the maximum swing angle.
+     */
+    float cosHalfSwing[KINEMATIC_MAX_SEGMENTS];
+
+    /**
+     * @brief Cosine of half the maximum twist angle.
+     */
+    float cosHalfTwist[KINEMATIC_MAX_SEGMENTS];
+
+    /**
+     * @brief Scratch positions for FABRIK.
+     */
+    Vector points[KINEMATIC_MAX_SEGMENTS];
+
+    /**
+     * @brief Scratch bone lengths for FABRIK.
+     */
+    float lengths[KINEMATIC_MAX_SEGMENTS];
+
+    /**
+     * @brief Iteration cap.
+     */
+    size_t maxIterations;
+
+    /**
+     * @brief Convergence distance.
+     */
+    float tolerance;
+
+    /**
+     * @brief Rotate joint @p seg by @p delta (world frame), apply its limit
+     * and store the new local rotation.
+     *
+     * @param tree Tree being solved.
+     * @param seg Segment index.
+     * @param delta World-frame rotation increment.
+     */
+    void rotateJoint(
+        KinematicTree& tree,
+        size_t seg,
+        const Quaternion& delta) const;
+
+    /**
+     * @brief Clamp a local rotation to the joint's limit.
+     *
+     * @param seg Segment index.
+     * @param q Local rotation.
+     * @return Constrained local rotation.
+     */
+    Quaternion constrain(size_t seg, const Quaternion& q) const;
+
+  public:
+    /**
+     * @brief Construct a new IKSolver.
+     *
+     * @param iterations Iteration cap per solve.
+     * @param tol Convergence distance, in the tree's length unit.
+     */
+    explicit IKSolver(size_t iterations = 16, float tol = 1e-3f);
+
+    /**
+     * @brief Select the chain running from @p root down to @p effector.
+     *
+     * @param tree Kinematic tree.
+     * @param root First joint of the chain.
+     * @param effector End effector segment.
+     * @return true if @p root is an ancestor of @p effector.
+     * @return false otherwise, the chain is left empty.
+     */
+    bool setChain(const KinematicTree& tree, size_t root, size_t effector);
+
+    /**
+     * @brief Number of segments in the chain, end effector included.
+     *
+     * @return size_t
+     */
+    size_t chainLength() const;
+
+    /**
+     * @brief Limit a joint's local rotation.
+     *
+     * @param seg Segment index.
+     * @param twistAxis Twist axis in the joint's local frame.
+     * @param maxSwing Maximum swing angle (radians).
+     * @param maxTwist Maximum twist angle (radians).
+     */
+    void setJointLimit(
+        size_t seg,
+        const Vector& twistAxis,
+        float maxSwing,
+        float maxTwist);
+
+    /**
+     * @brief Remove a joint's limit.
+     *
+     * @param seg Segment index.
+     */
+    void clearJointLimit(size_t seg);
+
+    /**
+     * @brief Set the iteration cap.
+     *
+     * @param iterations Iterations per solve.
+     */
+    void setMaxIterations(size_t iterations);
+
+    /**
+     * @brief Set the convergence distance.
+     *
+     * @param tol Distance.
+     */
+    void setTolerance(float tol);
+
+    /**
+     * @brief Cyclic coordinate descent.
+     * Joints are visited from the effector to the root, each one turned to
+     * align the effector with the target. The tree is updated in place.
+     *
+     * @param tree Kinematic tree holding the chain.
+     * @param target Target position of the end effector.
+     * @return IKResult
+     */
+    IKResult solveCCD(KinematicTree& tree, const Vector& target);
+
+    /**
+     * @brief Forward and backward reaching inverse kinematics.
+     * Positions are solved first, then converted back to local rotations
+     * (limits are applied during that conversion).
+     *
+     * @param tree Kinematic tree holding the chain.
+     * @param target Target position of the end effector.
+     * @return IKResult
+     */
+    IKResult solveFABRIK(KinematicTree& tree, const Vector& target);
+};
+
+#endif /* __LIB_CUSTOM_TYPE_IK_H__ */
@@ -0,0 +1,195 @@
+/**
+ * @file kinematics.cpp
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Kinematic tree with incremental forward kinematics.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "kinematics.h"
+
+KinematicTree::KinematicTree() :
+    parents {},
+    dirty {},
+    count { 0 },
+    firstDirty { KINEMATIC_NONE } {}
+
+void KinematicTree::markDirty(size_t idx) {
+    dirty[idx] = true;
+    if (firstDirty == KINEMATIC_NONE || idx < firstDirty) {
+        firstDirty = idx;
+    }
+}
+
+size_t KinematicTree::addSegment(
+    size_t parent,
+    const Vector& offset,
+    const Quaternion& rotation) {
+    if (count >= KINEMATIC_MAX_SEGMENTS) {
+        return KINEMATIC_NONE;
+    }
+    if (parent != KINEMATIC_NONE && parent >= count) {
+        return KINEMATIC_NONE;
+    }
+
+    const size_t idx { count++ };
+    parents[idx] = parent;
+    locals[idx] = rotation;
+    offsets[idx] = offset;
+    markDirty(idx);
+
+    return idx;
+}
+
+void KinematicTree::clear() {
+    for (size_t i {}; i < count; i++) {
+        dirty[i] = false;
+    }
+    count = 0;
+    firstDirty = KINEMATIC_NONE;
+}
+
+size_t KinematicTree::size() const {
+    return count;
+}
+
+size_t KinematicTree::parent(size_t idx) const {
+    return parents[idx];
+}
+
+void KinematicTree::setLocalRotation(size_t idx, const Quaternion& q) {
+    locals[idx] = q;
+    markDirty(idx);
+}
+
+Quaternion KinematicTree::localRotation(size_t idx) const {
+    return locals[idx];
+}
+
+void KinematicTree::setOffset(size_t idx, const Vector& offset) {
+    offsets[idx] = offset;
+    markDirty(idx);
+}
+
+Vector KinematicTree::offset(size_t idx) const {
+    return offsets[idx];
+}
+
+bool KinematicTree::isDirty() const {
+    return firstDirty != KINEMATIC_NONE;
+}
+
+size_t KinematicTree::update() {
+    if (firstDirty == KINEMATIC_NONE) {
+        return 0;
+    }
+
+    size_t recomputed {};
+
+    // parents come first, so their dirty flag is final when a child is seen
+    for (size_t i { firstDirty }; i < count; i++) {
+        const size_t p { parents[i] };
+        if (p != KINEMATIC_NONE && dirty[p]) {
+            dirty[i] = true;
+        }
+        if (!dirty[i]) {
+            continue;
+        }
+
+        if (p == KINEMATIC_NONE) {
+            worldRotations[i] = locals[i];
+            worldPositions[i] = offsets[i];
+        } else {
+            worldRotations[i] = worldRotations[p] * locals[i];
+            worldPositions[i] =
+                worldPositions[p] + worldRotations[p].rotate(offsets[i]);
+        }
+        recomputed++;
+    }
+
+    for (size_t i { firstDirty }; i < count; i++) {
+        dirty[i] = false;
+    }
+    firstDirty = KINEMATIC_NONE;
+
+    return recomputed;
+}
+
+Quaternion KinematicTree::worldRotation(size_t idx) const {
+    return worldRotations[idx];
+}
+
+Vector KinematicTree::worldPosition(size_t idx) const {
+    return worldPositions[idx];
+}
+
+void KinematicTree::forwardBatch(
+    const QuaternionArray& localRotations,
+    QuaternionArray& outRotations,
+    VectorArray& outPositions,
+    size_t skeletons) const {
+    for (size_t s {}; s < count; s++) {
+        const size_t row { s * skeletons };
+        const float* CST_RESTRICT lw { localRotations.w + row };
+        const float* CST_RESTRICT lx { localRotations.x + row };
+        const float* CST_RESTRICT ly { localRotations.y + row };
+        const float* CST_RESTRICT lz { localRotations.z + row };
+        float* ow { outRotations.w + row };
+        float* ox { outRotations.x + row };
+        float* oy { outRotations.y + row };
+        float* oz { outRotations.z + row };
+        float* px { outPositions.x + row };
+        float* py { outPositions.y + row };
+        float* pz { outPositions.z + row };
+        const Vector& o { offsets[s] };
+
+        if (parents[s] == KINEMATIC_NONE) {
+            CST_IVDEP
+            for (size_t k {}; k < skeletons; k++) {
+                ow[k] = lw[k];
+                ox[k] = lx[k];
+                oy[k] = ly[k];
+                oz[k] = lz[k];
+                px[k] = o.x;
+                py[k] = o.y;
+                pz[k] = o.z;
+            }
+            continue;
+        }
+
+        const size_t prow { parents[s] * skeletons };
+        const float* qw { outRotations.w + prow };
+        const float* qx { outRotations.x + prow };
+        const float* qy { outRotations.y + prow };
+        const float* qz { outRotations.z + prow };
+        const float* qpx { outPositions.x + prow };
+        const float* qpy { outPositions.y + prow };
+        const float* qpz { outPositions.z + prow };
+
+        CST_IVDEP
+        for (size_t k {}; k < skeletons; k++) {
+            const float aw { qw[k] };
+            const float ax { qx[k] };
+            const float ay { qy[k] };
+            const float az { qz[k] };
+
+            // world = parent * local
+            ow[k] = aw * lw[k] - ax * lx[k] - ay * ly[k] - az * lz[k];
+            ox[k] = aw * lx[k] + ax * lw[k] + ay * lz[k] - az * ly[k];
+            oy[k] = aw * ly[k] - ax * lz[k] + ay * lw[k] + az * lx[k];
+            oz[k] = aw * lz[k] + ax * ly[k] - ay * lx[k] + az * lw[k];
+
+            // position = parent position + parent rotation * offset
+            const float tx { 2.0f * (ay * o.z - az * o.y) };
+            const float ty { 2.0f * (az * o.x - ax * o.z) };
+            const float tz { 2.0f * (ax * o.y - ay * o.x) };
+            px[k] = qpx[k] + o.x + aw * tx + (ay * tz - az * ty);
+            py[k] = qpy[k] + o.y + aw * ty + (az * tx - ax * tz);
+            pz[k] = qpz[k] + o.z + aw * tz + (ax * ty - ay * tx);
+        }
+    }
+}
@@ -0,0 +1,217 @@
+/**
+ * @file kinematics.h
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Kinematic tree with incremental forward kinematics.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef __LIB_CUSTOM_TYPE_KINEMATICS_H__
+#define __LIB_CUSTOM_TYPE_KINEMATICS_H__
+
+#include <stddef.h>
+#include "def.h"
+#include "vector.h"
+#include "quaternion.h"
+#include "arrays.h"
+
+/**
+ * @brief Maximum number of segments in a tree.
+ */
+const size_t KINEMATIC_MAX_SEGMENTS { 32 };
+
+/**
+ * @brief Parent index of root segments, also returned on failure.
+ */
+const size_t KINEMATIC_NONE { static_cast<size_t>(-1) };
+
+/**
+ * @class KinematicTree
+ * @brief Creates a kinematic tree stored as flat, topologically sorted
+ * arrays: a segment's parent always has a lower index.
+ *
+ * Each segment holds its rotation relative to its parent and the offset of
+ * its origin in the parent's frame. World orientations and positions are
+ * cached and only recomputed for dirty subtrees by #update.
+ */
+class KinematicTree {
+  private:
+    /**
+     * @brief Parent of each segment, #KINEMATIC_NONE for roots.
+     */
+    size_t parents[KINEMATIC_MAX_SEGMENTS];
+
+    /**
+     * @brief Rotation relative to the parent.
+     */
+    Quaternion locals[KINEMATIC_MAX_SEGMENTS];
+
+    /**
+     * @brief Origin in the parent's frame (world frame for roots).
+     */
+    Vector offsets[KINEMATIC_MAX_SEGMENTS];
+
+    /**
+     * @brief Cached world orientations.
+     */
+    Quaternion worldRotations[KINEMATIC_MAX_SEGMENTS];
+
+    /**
+     * @brief Cached world positions.
+     */
+    Vector worldPositions[KINEMATIC_MAX_SEGMENTS];
+
+    /**
+     * @brief Segments whose local state changed since the last update.
+     */
+    bool dirty[KINEMATIC_MAX_SEGMENTS];
+
+    /**
+     * @brief Number of segments.
+     */
+    size_t count;
+
+    /**
+     * @brief Lowest dirty index, #KINEMATIC_NONE if the cache is valid.
+     */
+    size_t firstDirty;
+
+    /**
+     * @brief Flag segment @p idx and remember where #update starts.
+     *
+     * @param idx Segment index.
+     */
+    void markDirty(size_t idx);
+
+  public:
+    /**
+     * @brief Construct an empty tree.
+     */
+    KinematicTree();
+
+    /**
+     * @brief Append a segment.
+     * The parent must already exist, which keeps the arrays sorted.
+     *
+     * @param parent Parent index or #KINEMATIC_NONE for a root.
+     * @param offset Origin in the parent's frame.
+     * @param rotation Rotation relative to the parent.
+     * @return Index of the new segment, #KINEMATIC_NONE if the tree is full
+     * or the parent is invalid.
+     */
+    size_t addSegment(
+        size_t parent,
+        const Vector& offset,
+        const Quaternion& rotation = Quaternion {});
+
+    /**
+     * @brief Remove all segments.
+     */
+    void clear();
+
+    /**
+     * @brief Number of segments.
+     *
+     * @return size_t
+     */
+    size_t size() const;
+
+    /**
+     * @brief Parent of segment @p idx.
+     *
+     * @param idx Segment index.
+     * @return Parent index or #KINEMATIC_NONE.
+     */
+    size_t parent(size_t idx) const;
+
+    /**
+     * @brief Set the rotation of segment @p idx relative to its parent.
+     *
+     * @param idx Segment index.
+     * @param q Unit #Quaternion.
+     */
+    void setLocalRotation(size_t idx, const Quaternion& q);
+
+    /**
+     * @brief Rotation of segment @p idx relative to its parent.
+     *
+     * @param idx Segment index.
+     * @return Quaternion
+     */
+    Quaternion localRotation(size_t idx) const;
+
+    /**
+     * @brief Set the origin of segment @p idx in its parent's frame.
+     *
+     * @param idx Segment index.
+     * @param offset #Vector.
+     */
+    void setOffset(size_t idx, const Vector& offset);
+
+    /**
+     * @brief Origin of segment @p idx in its parent's frame.
+     *
+     * @param idx Segment index.
+     * @return Vector
+     */
+    Vector offset(size_t idx) const;
+
+    /**
+     * @brief Verify if some world transforms are out of date.
+     *
+     * @return true if #update has work to do.
+     * @return false otherwise.
+     */
+    bool isDirty() const;
+
+    /**
+     * @brief Incremental forward kinematics.
+     * A single pass from the first dirty segment recomputes dirty segments
+     * and their descendants, clean branches are skipped.
+     *
+     * @return Number of segments recomputed.
+     */
+    size_t update();
+
+    /**
+     * @brief World orientation of segment @p idx as of the last #update.
+     *
+     * @param idx Segment index.
+     * @return Quaternion
+     */
+    Quaternion worldRotation(size_t idx) const;
+
+    /**
+     * @brief World position of segment @p idx as of the last #update.
+     *
+     * @param idx Segment index.
+     * @return Vector
+     */
+    Vector worldPosition(size_t idx) const;
+
+    /**
+     * @brief Batch forward kinematics of many skeletons sharing this tree's
+     * topology and offsets.
+     *
+     * Arrays are segment-major: element @f$s\cdot skeletons+k@f$ belongs to
+     * segment @f$s@f$ of skeleton @f$k@f$, so the inner loop runs over
+     * skeletons with unit stride. The arrays hold
+     * @f$size()\cdot skeletons@f$ elements.
+     *
+     * @param localRotations Rotations relative to parents.
+     * @param outRotations World orientations.
+     * @param outPositions World positions.
+     * @param skeletons Number of skeletons.
+     */
+    void forwardBatch(
+        const QuaternionArray& localRotations,
+        QuaternionArray& outRotations,
+        VectorArray& outPositions,
+        size_t skeletons) const;
+};
+
+#endif /* __LIB_CUSTOM_TYPE_KINEMATICS_H__ */
@@ -0,0 +1,289 @@
+/**
+ * @file magcalibration.cpp
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Streaming hard/soft-iron magnetometer calibration.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "magcalibration.h"
+
+namespace {
+/**
+ * @brief Solve a symmetric positive definite system with a Cholesky
+ * factorisation.
+ *
+ * @param a Matrix, only the upper triangle is read.
+ * @param b Right-hand side.
+ * @param x Solution.
+ * @return false if @p a is not positive definite.
+ */
+bool choleskySolve(
+    const float a[MAG_FIT_TERMS][MAG_FIT_TERMS],
+    const float b[MAG_FIT_TERMS],
+    float x[MAG_FIT_TERMS]) {
+    float l[MAG_FIT_TERMS][MAG_FIT_TERMS];
+
+    for (size_t j {}; j < MAG_FIT_TERMS; j++) {
+        float d { a[j][j] };
+        for (size_t k {}; k < j; k++) {
+            d -= cst::sqr(l[j][k]);
+        }
+        if (d <= 0.0f) {
+            return false;
+        }
+        l[j][j] = sqrtf(d);
+
+        const float inv { 1.0f / l[j][j] };
+        for (size_t i { j + 1 }; i < MAG_FIT_TERMS; i++) {
+            float s { a[j][i] };
+            for (size_t k {}; k < j; k++) {
+                s -= l[i][k] * l[j][k];
+            }
+            l[i][j] = s * inv;
+        }
+    }
+
+    // L y = b, then L^T x = y
+    for (size_t i {}; i < MAG_FIT_TERMS; i++) {
+        float s { b[i] };
+        for (size_t k {}; k < i; k++) {
+            s -= l[i][k] * x[k];
+        }
+        x[i] = s / l[i][i];
+    }
+    for (size_t i { MAG_FIT_TERMS }; i-- > 0;) {
+        float s { x[i] };
+        for (size_t k { i + 1 }; k < MAG_FIT_TERMS; k++) {
+            s -= l[k][i] * x[k];
+        }
+        x[i] = s / l[i][i];
+    }
+
+    return true;
+}
+
+/**
+ * @brief Square root of a symmetric positive definite matrix
+ * (Denman-Beavers iteration), converges quickly for @f$\det(m)\approx1@f$.
+ *
+ * @param m Matrix3x3.
+ * @return Matrix3x3
+ */
+Matrix3x3 squareRoot(const Matrix3x3& m) {
+    Matrix3x3 y { m };
+    Matrix3x3 z { Matrix3x3::identity() };
+
+    for (size_t i {}; i < 12; i++) {
+        const Matrix3x3 yInv { y.inverse() };
+        y = (y + z.inverse()) * 0.5f;
+        z = (z + yInv) * 0.5f;
+    }
+
+    return y;
+}
+}  // namespace
+
+MagCalibrator::MagCalibrator() :
+    count { 0 },
+    scale { 1.0f },
+    hard {},
+    soft { Matrix3x3::identity() } {
+    reset();
+}
+
+void MagCalibrator::reset() {
+    for (size_t r {}; r < MAG_FIT_TERMS; r++) {
+        for (size_t c {}; c < MAG_FIT_TERMS; c++) {
+            normal[r][c] = 0.0f;
+        }
+        rhs[r] = 0.0f;
+    }
+    count = 0;
+    scale = 1.0f;
+}
+
+void MagCalibrator::add(const Vector& m) {
+    if (count == 0) {
+        const float n { m.norm() };
+        scale = n > 0.0f ? n : 1.0f;
+    }
+
+    const Vector u { m / scale };
+    const float d[MAG_FIT_TERMS] {
+        u.x * u.x,
+        u.y * u.y,
+        u.z * u.z,
+        2.0f * u.x * u.y,
+        2.0f * u.x * u.z,
+        2.0f * u.y * u.z,
+        2.0f * u.x,
+        2.0f * u.y,
+        2.0f * u.z,
+    };
+
+    for (size_t r {}; r < MAG_FIT_TERMS; r++) {
+        for (size_t c { r }; c < MAG_FIT_TERMS; c++) {
+            normal[r][c] += d[r] * d[c];
+        }
+        rhs[r] += d[r];
+    }
+    count++;
+}
+
+void MagCalibrator::add(const VectorArray& ms) {
+    const size_t n { ms.length };
+    if (n == 0) {
+        return;
+    }
+    if (count == 0) {
+        const float first { ms.get(0).norm() };
+        scale = first > 0.0f ? first : 1.0f;
+    }
+
+    const float inv { 1.0f / scale };
+    float d[MAG_FIT_TERMS][MAG_FIT_BLOCK];
+
+    for (size_t start {}; start < n; start += MAG_FIT_BLOCK) {
+        const size_t len {
+            n - start < MAG_FIT_BLOCK ? n - start : MAG_FIT_BLOCK
+        };
+        const float* CST_RESTRICT xs { ms.x + start };
+        const float* CST_RESTRICT ys { ms.y + start };
+        const float* CST_RESTRICT zs { ms.z + start };
+
+        CST_IVDEP
+        for (size_t k {}; k < len; k++) {
+            const float x { xs[k] * inv };
+            const float y { ys[k] * inv };
+            const float z { zs[k] * inv };
+            d[0][k] = x * x;
+            d[1][k] = y * y;
+            d[2][k] = z * z;
+            d[3][k] = 2.0f * x * y;
+            d[4][k] = 2.0f * x * z;
+            d[5][k] = 2.0f * y * z;
+            d[6][k] = 2.0f * x;
+            d[7][k] = 2.0f * y;
+            d[8][k] = 2.0f * z;
+        }
+
+        for (size_t r {}; r < MAG_FIT_TERMS; r++) {
+            for (size_t k { len }; k < MAG_FIT_BLOCK; k++) {
+                d[r][k] = 0.0f;
+            }
+        }
+
+        // pairwise sums over the (zero padded) block
+        for (size_t r {}; r < MAG_FIT_TERMS; r++) {
+            for (size_t c { r }; c < MAG_FIT_TERMS; c++) {
+                float s[MAG_FIT_BLOCK / 2];
+                for (size_t k {}; k < MAG_FIT_BLOCK / 2; k++) {
+                    s[k] = d[r][k] * d[c][k]
+                        + d[r][k + MAG_FIT_BLOCK / 2]
+                            * d[c][k + MAG_FIT_BLOCK / 2];
+                }
+                normal[r][c] += cst::pairwiseSum(s, MAG_FIT_BLOCK / 2);
+            }
+            float s[MAG_FIT_BLOCK / 2];
+            for (size_t k {}; k < MAG_FIT_BLOCK / 2; k++) {
+                s[k] = d[r][k] + d[r][k + MAG_FIT_BLOCK / 2];
+            }
+            rhs[r] += cst::pairwiseSum(s, MAG_FIT_BLOCK / 2);
+        }
+    }
+
+    count += n;
+}
+
+size_t MagCalibrator::samples() const {
+    return count;
+}
+
+bool MagCalibrator::solve(float fieldStrength) {
+    if (count < MAG_FIT_TERMS) {
+        return false;
+    }
+
+    float p[MAG_FIT_TERMS];
+    if (!choleskySolve(normal, rhs, p)) {
+        return false;
+    }
+
+    // quadric x^T A x + 2 b^T x = 1, centre c = -A^-1 b:
+    // (x - c)^T A (x - c) = 1 - b^T c
+    const Matrix3x3 a { p[0], p[3], p[4], p[3], p[1], p[5], p[4], p[5], p[2] };
+    const float det { a.det() };
+    if (p[0] <= 0.0f || p[0] * p[1] - p[3] * p[3] <= 0.0f || det <= 0.0f) {
+        return false;
+    }
+
+    const Vector b { p[6], p[7], p[8] };
+    const Vector centre { -(a.inverse() * b) };
+    const float r { 1.0f - b.dot(centre) };
+    if (r <= 0.0f) {
+        return false;
+    }
+
+    // M = A / r maps the ellipsoid to the unit sphere, det(M) = k^3;
+    // sqrt(M / k) keeps the geometric mean radius
+    const float k { cbrtf(det) / r };
+    const Matrix3x3 w { squareRoot(a * (1.0f / (r * k))) };
+
+    hard = centre * scale;
+    soft = fieldStrength > 0.0f
+        ? w * (fieldStrength * sqrtf(k) / scale)
+        : w;
+
+    return true;
+}
+
+Vector MagCalibrator::hardIron() const {
+    return hard;
+}
+
+Matrix3x3 MagCalibrator::softIron() const {
+    return soft;
+}
+
+Vector MagCalibrator::apply(const Vector& m) const {
+    return soft * (m - hard);
+}
+
+void MagCalibrator::apply(const VectorArray& ms, VectorArray& out) const {
+    const float* xs { ms.x };
+    const float* ys { ms.y };
+    const float* zs { ms.z };
+    float* ox { out.x };
+    float* oy { out.y };
+    float* oz { out.z };
+    const float hx { hard.x };
+    const float hy { hard.y };
+    const float hz { hard.z };
+    const float w11 { soft.coeff(0, 0) };
+    const float w12 { soft.coeff(0, 1) };
+    const float w13 { soft.coeff(0, 2) };
+    const float w21 { soft.coeff(1, 0) };
+    const float w22 { soft.coeff(1, 1) };
+    const float w23 { soft.coeff(1, 2) };
+    const float w31 { soft.coeff(2, 0) };
+    const float w32 { soft.coeff(2, 1) };
+    const float w33 { soft.coeff(2, 2) };
+    const size_t n { ms.length };
+
+    // no restrict: in-place correction is allowed, each element is read
+    // before it is written
+    CST_IVDEP
+    for (size_t i {}; i < n; i++) {
+        const float x { xs[i] - hx };
+        const float y { ys[i] - hy };
+        const float z { zs[i] - hz };
+        ox[i] = w11 * x + w12 * y + w13 * z;
+        oy[i] = w21 * x + w22 * y + w23 * z;
+        oz[i] = w31 * x + w32 * y + w33 * z;
+    }
+}
@@ -0,0 +1,150 @@
+/**
+ * @file magcalibration.h
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Streaming hard/soft-iron magnetometer calibration.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef __LIB_CUSTOM_TYPE_MAGCALIBRATION_H__
+#define __LIB_CUSTOM_TYPE_MAGCALIBRATION_H__
+
+#include <stddef.h>
+#include "def.h"
+#include "vector.h"
+#include "matrix.h"
+#include "arrays.h"
+
+/**
+ * @brief Number of ellipsoid parameters.
+ */
+const size_t MAG_FIT_TERMS { 9 };
+
+/**
+ * @brief Samples per block in the batch accumulation (power of 2).
+ */
+const size_t MAG_FIT_BLOCK { 32 };
+
+/**
+ * @class MagCalibrator
+ * @brief Least-squares ellipsoid fit accumulated in fixed memory.
+ *
+ * Samples are fitted to
+ * @f$ax^2+by^2+cz^2+2dxy+2exz+2fyz+2gx+2hy+2iz=1@f$. Only the 9x9 normal
+ * equations are stored (upper triangle used), samples are discarded once
+ * accumulated. #solve factorises them and turns the quadric into a hard-iron
+ * offset and a symmetric soft-iron matrix:
+ * @f$m_{cal}=W(m_{raw}-o)@f$ lies on a sphere.
+ *
+ * Samples are scaled by the norm of the first one to keep the sums well
+ * conditioned in single precision. The fit degenerates if the origin lies on
+ * the ellipsoid (offset close to the field strength).
+ */
+class MagCalibrator {
+  private:
+    /**
+     * @brief Normal matrix @f$D^TD@f$, upper triangle.
+     */
+    float normal[MAG_FIT_TERMS][MAG_FIT_TERMS];
+    /**
+     * @brief Right-hand side @f$D^T1@f$.
+     */
+    float rhs[MAG_FIT_TERMS];
+    /**
+     * @brief Number of accumulated samples.
+     */
+    size_t count;
+    /**
+     * @brief Sample scale, norm of the first sample.
+     */
+    float scale;
+    /**
+     * @brief Hard-iron offset.
+     */
+    Vector hard;
+    /**
+     * @brief Soft-iron correction.
+     */
+    Matrix3x3 soft;
+
+  public:
+    /**
+     * @brief Construct a new MagCalibrator object.
+     * The correction is the identity until #solve succeeds.
+     */
+    MagCalibrator();
+
+    /**
+     * @brief Drop the accumulated samples, keep the correction.
+     */
+    void reset();
+
+    /**
+     * @brief Accumulate one sample.
+     *
+     * @param m Raw magnetometer sample.
+     */
+    void add(const Vector& m);
+
+    /**
+     * @brief Accumulate a recorded dataset. Products are summed per block
+     * of #MAG_FIT_BLOCK samples (vectorisable) before being added to the
+     * normal equations.
+     *
+     * @param ms Raw magnetometer samples.
+     */
+    void add(const VectorArray& ms);
+
+    /**
+     * @brief Number of accumulated samples.
+     *
+     * @return size_t
+     */
+    size_t samples() const;
+
+    /**
+     * @brief Fit the ellipsoid and update the correction.
+     *
+     * @param fieldStrength Radius of the corrected sphere, in the sample
+     * unit. 0 keeps the geometric mean radius of the fitted ellipsoid.
+     * @return false if there are fewer than #MAG_FIT_TERMS samples or the
+     * fit is not an ellipsoid (the correction is left unchanged).
+     */
+    bool solve(float fieldStrength = 0.0f);
+
+    /**
+     * @brief Hard-iron offset.
+     *
+     * @return Vector
+     */
+    Vector hardIron() const;
+
+    /**
+     * @brief Soft-iron correction matrix.
+     *
+     * @return Matrix3x3
+     */
+    Matrix3x3 softIron() const;
+
+    /**
+     * @brief Correct one sample.
+     *
+     * @param m Raw sample.
+     * @return Calibrated sample.
+     */
+    Vector apply(const Vector& m) const;
+
+    /**
+     * @brief Correct samples in one fused pass (offset and matrix).
+     *
+     * @param ms Raw samples.
+     * @param out Calibrated samples, same length as @p ms, may be @p ms.
+     */
+    void apply(const VectorArray& ms, VectorArray& out) const;
+};
+
+#endif /* __LIB_CUSTOM_TYPE_MAGCALIBRATION_H__ */
@@ -126,8 +126,84 @@ Vector Matrix3x3::operator*(const Vector& rhs) const {
     };
 }
 
-float Matrix3x3::det() {
+Matrix3x3 Matrix3x3::operator*(const Matrix3x3& rhs) const {
+    float tmp[MATRIX_LEN];
+
+    for (size_t r {}; r < MATRIX_ROWS; r++) {
+        for (size_t c {}; c < MATRIX_COLS; c++) {
+            tmp[index(r, c)] = coeff(r, 0) * rhs.coeff(0, c)
+                + coeff(r, 1) * rhs.coeff(1, c)
+                + coeff(r, 2) * rhs.coeff(2, c);
+        }
+    }
+
+    return Matrix3x3 { tmp };
+}
+
+Matrix3x3 Matrix3x3::operator*(float n) const {
+    float tmp[MATRIX_LEN];
+
+    for (size_t i {}; i < MATRIX_LEN; i++) {
+        tmp[i] = members[i] * n;
+    }
+
+    return Matrix3x3 { tmp };
+}
+
+Matrix3x3 Matrix3x3::operator+(const Matrix3x3& rhs) const {
+    float tmp[MATRIX_LEN];
+
+    for (size_t i {}; i < MATRIX_LEN; i++) {
+        tmp[i] = members[i] + rhs.members[i];
+    }
+
+    return Matrix3x3 { tmp };
+}
+
+Matrix3x3 Matrix3x3::operator-(const Matrix3x3& rhs) const {
+    float tmp[MATRIX_LEN];
+
+    for (size_t i {}; i < MATRIX_LEN; i++) {
+        tmp[i] = members[i] - rhs.members[i];
+    }
+
+    return Matrix3x3 { tmp };
+}
+
+Matrix3x3& Matrix3x3::operator+=(const Matrix3x3& rhs) {
+    for (size_t i {}; i < MATRIX_LEN; i++) {
+        members[i] += rhs.members[i];
+    }
+
+    return *this;
+}
+
+Matrix3x3& Matrix3x3::operator-=(const Matrix3x3& rhs) {
+    for (size_t i {}; i < MATRIX_LEN; i++) {
+        members[i] -= rhs.members[i];
+    }
+
+    return *this;
+}
+
+float Matrix3x3::det() const {
     return coeff(0, 0) * (coeff(1, 1) * coeff(2, 2) - coeff(1, 2) * coeff(2, 1))
         + coeff(0, 1) * (coeff(1, 2) * coeff(2, 0) - coeff(1, 0) * coeff(2, 2))
         + coeff(0, 2) * (coeff(1, 0) * coeff(2, 1) - coeff(1, 1) * coeff(2, 0));
-}
\ No newline at end of file
+}
+
+Matrix3x3 Matrix3x3::inverse() const {
+    const float inv { 1.0f / det() };
+
+    return Matrix3x3 {
+        (coeff(1, 1) * coeff(2, 2) - coeff(1, 2) * coeff(2, 1)) * inv,
+        (coeff(0, 2) * coeff(2, 1) - coeff(0, 1) * coeff(2, 2)) * inv,
+        (coeff(0, 1) * coeff(1, 2) - coeff(0, 2) * coeff(1, 1)) * inv,
+        (coeff(1, 2) * coeff(2, 0) - coeff(1, 0) * coeff(2, 2)) * inv,
+        (coeff(0, 0) * coeff(2, 2) - coeff(0, 2) * coeff(2, 0)) * inv,
+        (coeff(0, 2) * coeff(1, 0) - coeff(0, 0) * coeff(1, 2)) * inv,
+        (coeff(1, 0) * coeff(2, 1) - coeff(1, 1) * coeff(2, 0)) * inv,
+        (coeff(0, 1) * coeff(2, 0) - coeff(0, 0) * coeff(2, 1)) * inv,
+        (coeff(0, 0) * coeff(1, 1) - coeff(0, 1) * coeff(1, 0)) * inv,
+    };
+}
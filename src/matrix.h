@@ -121,6 +121,19 @@ class Matrix3x3 {
         };
     }
 
+    /**
+     * @brief Static method to create the skew-symmetric (cross product)
+     * matrix of a vector, @f$[v]_\times w=v\times w@f$.
+     *
+     * @param v #Vector.
+     * @return Matrix3x3
+     */
+    static Matrix3x3 skew(const Vector& v) {
+        return Matrix3x3 {
+            0.0f, -v.z, v.y, v.z, 0.0f, -v.x, -v.y, v.x, 0.0f,
+        };
+    }
+
     /**
      * @brief Computes the sum of the diagonal elements.
      * @f$trace=a_{11}+a_{22}+a_{33}@f$
@@ -143,10 +156,66 @@ class Matrix3x3 {
      */
     Vector operator*(const Vector& rhs) const;
 
+    /**
+     * @brief Matrix-Matrix product.
+     *
+     * @param rhs Matrix3x3.
+     * @return Matrix3x3
+     */
+    Matrix3x3 operator*(const Matrix3x3& rhs) const;
+
+    /**
+     * @brief Element-wise multiplication by a scalar.
+     *
+     * @param n Multiplier.
+     * @return Matrix3x3
+     */
+    Matrix3x3 operator*(float n) const;
+
+    /**
+     * @brief Element-wise addition with a matrix.
+     *
+     * @param rhs Matrix3x3.
+     * @return Matrix3x3
+     */
+    Matrix3x3 operator+(const Matrix3x3& rhs) const;
+
+    /**
+     * @brief Element-wise subtraction with a matrix.
+     *
+     * @param rhs Matrix3x3.
+     * @return Matrix3x3
+     */
+    Matrix3x3 operator-(const Matrix3x3& rhs) const;
+
+    /**
+     * @brief Compound assignment addition with a matrix.
+     *
+     * @param rhs Matrix3x3.
+     * @return Matrix3x3&
+     */
+    Matrix3x3& operator+=(const Matrix3x3& rhs);
+
+    /**
+     * @brief Compound assignment subtraction with a matrix.
+     *
+     * @param rhs Matrix3x3.
+     * @return Matrix3x3&
+     */
+    Matrix3x3& operator-=(const Matrix3x3& rhs);
+
     /**
      * @brief Matrix determinant.
      */
-    float det();
+    float det() const;
+
+    /**
+     * @brief Matrix inverse (adjugate over determinant).
+     * A singular matrix yields non-finite members.
+     *
+     * @return Matrix3x3
+     */
+    Matrix3x3 inverse() const;
 
     /**
      * @brief Retrieve matrix member at row @p r and column @p c
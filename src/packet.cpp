@@ -0,0 +1,286 @@
+/**
+ * @file packet.cpp
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Framed Vector/Quaternion packets and a resumable decoder.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "packet.h"
+
+#include <string.h>
+
+namespace {
+/**
+ * @brief Payload length of a packet type.
+ *
+ * @param type Packet type.
+ * @return 0 for an unknown type.
+ */
+inline uint8_t payloadLength(uint8_t type) {
+    return type == PACKET_VECTOR ? 16 : (type == PACKET_QUATERNION ? 20 : 0);
+}
+
+/**
+ * @brief Write a little-endian uint32.
+ *
+ * @param out Buffer.
+ * @param v Value.
+ */
+inline void putU32(uint8_t* out, uint32_t v) {
+    out[0] = static_cast<uint8_t>(v);
+    out[1] = static_cast<uint8_t>(v >> 8);
+    out[2] = static_cast<uint8_t>(v >> 16);
+    out[3] = static_cast<uint8_t>(v >> 24);
+}
+
+/**
+ * @brief Read a little-endian uint32.
+ *
+ * @param in Buffer.
+ * @return uint32_t
+ */
+inline uint32_t getU32(const uint8_t* in) {
+    return static_cast<uint32_t>(in[0]) | static_cast<uint32_t>(in[1]) << 8
+        | static_cast<uint32_t>(in[2]) << 16
+        | static_cast<uint32_t>(in[3]) << 24;
+}
+
+/**
+ * @brief Write a little-endian float32.
+ *
+ * @param out Buffer.
+ * @param f Value.
+ */
+inline void putFloat(uint8_t* out, float f) {
+    uint32_t v;
+    memcpy(&v, &f, sizeof(v));
+    putU32(out, v);
+}
+
+/**
+ * @brief Read a little-endian float32.
+ *
+ * @param in Buffer.
+ * @return float
+ */
+inline float getFloat(const uint8_t* in) {
+    const uint32_t v { getU32(in) };
+    float f;
+    memcpy(&f, &v, sizeof(f));
+
+    return f;
+}
+
+/**
+ * @brief Fletcher-16 checksum.
+ *
+ * @param in Bytes.
+ * @param n Number of bytes.
+ * @return First sum in the low byte, second sum in the high byte.
+ */
+inline uint16_t fletcher16(const uint8_t* in, size_t n) {
+    uint16_t sum1 {};
+    uint16_t sum2 {};
+    for (size_t i {}; i < n; i++) {
+        sum1 = static_cast<uint16_t>((sum1 + in[i]) % 255);
+        sum2 = static_cast<uint16_t>((sum2 + sum1) % 255);
+    }
+
+    return static_cast<uint16_t>(sum2 << 8 | sum1);
+}
+}  // namespace
+
+Packet::Packet() :
+    type { PACKET_VECTOR },
+    channel { 0 },
+    timestamp { 0 },
+    vector {},
+    quaternion {} {}
+
+Packet::Packet(uint8_t ch, uint32_t t, const Vector& v) :
+    type { PACKET_VECTOR },
+    channel { ch },
+    timestamp { t },
+    vector { v },
+    quaternion {} {}
+
+Packet::Packet(uint8_t ch, uint32_t t, const Quaternion& q) :
+    type { PACKET_QUATERNION },
+    channel { ch },
+    timestamp { t },
+    vector {},
+    quaternion { q } {}
+
+size_t Packet::encode(uint8_t* out) const {
+    const uint8_t length { payloadLength(type) };
+    uint8_t* payload { out + 5 };
+
+    out[0] = PACKET_SYNC1;
+    out[1] = PACKET_SYNC2;
+    out[2] = type;
+    out[3] = channel;
+    out[4] = length;
+    putU32(payload, timestamp);
+    if (type == PACKET_QUATERNION) {
+        putFloat(payload + 4, quaternion.w);
+        putFloat(payload + 8, quaternion.x);
+        putFloat(payload + 12, quaternion.y);
+        putFloat(payload + 16, quaternion.z);
+    } else {
+        putFloat(payload + 4, vector.x);
+        putFloat(payload + 8, vector.y);
+        putFloat(payload + 12, vector.z);
+    }
+
+    // Fletcher-16 from the type to the end of the payload
+    const uint16_t sum { fletcher16(out + 2, 3u + length) };
+    out[5 + length] = static_cast<uint8_t>(sum);
+    out[6 + length] = static_cast<uint8_t>(sum >> 8);
+
+    return 7u + length;
+}
+
+PacketDecoder::PacketDecoder() {
+    reset();
+}
+
+void PacketDecoder::reset() {
+    size = 0;
+    parsed = 0;
+    last = Packet {};
+    fresh = false;
+    good = 0;
+    bad = 0;
+}
+
+bool PacketDecoder::valid() const {
+    // frame[0] is always the first sync byte
+    const size_t p { parsed - 1u };
+    if (p == 1) {
+        return frame[1] == PACKET_SYNC2;
+    }
+    if (p == 4) {
+        return frame[4] > 0 && frame[4] == payloadLength(frame[2]);
+    }
+    if (p > 4 && p == 6u + frame[4]) {
+        const uint16_t sum { fletcher16(frame + 2, 3u + frame[4]) };
+        return frame[p - 1] == static_cast<uint8_t>(sum)
+            && frame[p] == static_cast<uint8_t>(sum >> 8);
+    }
+
+    return true;
+}
+
+void PacketDecoder::discard(size_t count) {
+    size_t from { count };
+    while (from < size && frame[from] != PACKET_SYNC1) {
+        from++;
+    }
+    size = static_cast<uint8_t>(size - from);
+    memmove(frame, frame + from, size);
+    parsed = 0;
+}
+
+void PacketDecoder::finish() {
+    const uint8_t* payload { frame + 5 };
+
+    last.type = frame[2];
+    last.channel = frame[3];
+    last.timestamp = getU32(payload);
+    if (last.type == PACKET_QUATERNION) {
+        last.quaternion = Quaternion {
+            getFloat(payload + 4),
+            getFloat(payload + 8),
+            getFloat(payload + 12),
+            getFloat(payload + 16),
+        };
+    } else {
+        last.vector = Vector {
+            getFloat(payload + 4),
+            getFloat(payload + 8),
+            getFloat(payload + 12),
+        };
+    }
+}
+
+size_t PacketDecoder::decode(const uint8_t* data, size_t n) {
+    fresh = false;
+    size_t i {};
+
+    for (;;) {
+        // bytes kept from a rejected frame are parsed before new ones
+        while (parsed < size) {
+            parsed++;
+            if (!valid()) {
+                // a bad second sync byte is not counted as a frame
+                bad += parsed > 2 ? 1 : 0;
+                discard(1);
+            } else if (parsed > 5 && parsed == 7u + frame[4]) {
+                finish();
+                good++;
+                fresh = true;
+                discard(parsed);
+                return i;
+            }
+        }
+
+        if (i == n) {
+            return n;
+        }
+        if (size >= 5 && size < 5u + frame[4]) {
+            // payload bytes need no check, copy them in one run
+            size_t run { 5u + frame[4] - size };
+            run = run < n - i ? run : n - i;
+            memcpy(frame + size, data + i, run);
+            size = static_cast<uint8_t>(size + run);
+            parsed = size;
+            i += run;
+            continue;
+        }
+        const uint8_t b { data[i++] };
+        if (size > 0 || b == PACKET_SYNC1) {
+            frame[size++] = b;
+        }
+    }
+}
+
+size_t PacketDecoder::feed(
+    const uint8_t* data,
+    size_t n,
+    PacketHandler handler,
+    void* context) {
+    size_t count {};
+
+    while (n > 0) {
+        const size_t used { decode(data, n) };
+        data += used;
+        n -= used;
+        if (fresh) {
+            handler(context, last);
+            count++;
+        }
+    }
+
+    return count;
+}
+
+bool PacketDecoder::ready() const {
+    return fresh;
+}
+
+const Packet& PacketDecoder::packet() const {
+    return last;
+}
+
+size_t PacketDecoder::packets() const {
+    return good;
+}
+
+size_t PacketDecoder::errors() const {
+    return bad;
+}
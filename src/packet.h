@@ -0,0 +1,253 @@
+/**
+ * @file packet.h
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Framed Vector/Quaternion packets and a resumable decoder.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef __LIB_CUSTOM_TYPE_PACKET_H__
+#define __LIB_CUSTOM_TYPE_PACKET_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "def.h"
+#include "vector.h"
+#include "quaternion.h"
+
+/**
+ * @brief Frame start bytes.
+ */
+const uint8_t PACKET_SYNC1 { 0xA5 };
+const uint8_t PACKET_SYNC2 { 0x5A };
+
+/**
+ * @brief Packet types.
+ */
+const uint8_t PACKET_VECTOR { 1 };
+const uint8_t PACKET_QUATERNION { 2 };
+
+/**
+ * @brief Largest payload (bytes).
+ */
+const size_t PACKET_MAX_PAYLOAD { 20 };
+
+/**
+ * @brief Largest frame (bytes): sync, type, channel, length, payload and
+ * checksum.
+ */
+const size_t PACKET_MAX_FRAME { PACKET_MAX_PAYLOAD + 7 };
+
+/**
+ * @class Packet
+ * @brief Timestamped Vector or Quaternion sample of a sensor channel.
+ *
+ * Frame: @c A5 @c 5A, type, channel, payload length, payload, Fletcher-16
+ * checksum of type to payload. The payload is the timestamp (uint32, us)
+ * followed by 3 (Vector) or 4 (Quaternion) float32, all little-endian.
+ */
+class Packet {
+  public:
+    /**
+     * @brief #PACKET_VECTOR or #PACKET_QUATERNION.
+     */
+    uint8_t type;
+    /**
+     * @brief Sensor channel, e.g. gyro, accel, attitude.
+     */
+    uint8_t channel;
+    /**
+     * @brief Timestamp (microseconds).
+     */
+    uint32_t timestamp;
+    /**
+     * @brief Payload of a #PACKET_VECTOR.
+     */
+    Vector vector;
+    /**
+     * @brief Payload of a #PACKET_QUATERNION.
+     */
+    Quaternion quaternion;
+
+    /**
+     * @brief Construct an empty Vector Packet object.
+     */
+    Packet();
+
+    /**
+     * @brief Construct a Vector Packet object.
+     *
+     * @param ch Channel.
+     * @param t Timestamp (microseconds).
+     * @param v Sample.
+     */
+    Packet(uint8_t ch, uint32_t t, const Vector& v);
+
+    /**
+     * @brief Construct a Quaternion Packet object.
+     *
+     * @param ch Channel.
+     * @param t Timestamp (microseconds).
+     * @param q Sample.
+     */
+    Packet(uint8_t ch, uint32_t t, const Quaternion& q);
+
+    /**
+     * @brief Write the frame of the packet.
+     *
+     * @param out Buffer of at least #PACKET_MAX_FRAME bytes.
+     * @return Frame length (bytes).
+     */
+    size_t encode(uint8_t* out) const;
+};
+
+/**
+ * @brief Called for each decoded packet.
+ */
+typedef void (*PacketHandler)(void* context, const Packet& packet);
+
+/**
+ * @class PacketDecoder
+ * @brief Byte-at-a-time frame parser that can stop and resume anywhere.
+ *
+ * All of its state is one frame of bytes and a few counters, so one
+ * decoder per device multiplexes any number of devices on a single event
+ * loop (poll/epoll on a gateway, @c Serial.available() on a board) without
+ * threads or blocking reads: feed whatever bytes a non-blocking read
+ * returned and the handler, e.g. the device's fusion step, runs inline for
+ * each complete packet.
+ * @code
+ * ssize_t got { read(fd, buffer, sizeof(buffer)) };
+ * if (got > 0) {
+ *     decoders[device].feed(buffer, got, fuse, &filters[device]);
+ * }
+ * @endcode
+ *
+ * Frames with an unknown type, a wrong length or a bad checksum are
+ * dropped and the parser hunts for the next sync from the byte after the
+ * rejected one, so a frame starting inside a truncated or corrupted frame,
+ * or right after a stray sync, is still decoded.
+ */
+class PacketDecoder {
+  private:
+    /**
+     * @brief Bytes of the current frame from its sync, kept until the frame
+     * is accepted so that a rejected one can be scanned again.
+     */
+    uint8_t frame[PACKET_MAX_FRAME];
+    /**
+     * @brief Bytes in #frame.
+     */
+    uint8_t size;
+    /**
+     * @brief Bytes of #frame checked so far.
+     */
+    uint8_t parsed;
+    /**
+     * @brief Last complete packet.
+     */
+    Packet last;
+    /**
+     * @brief Whether the last #decode call completed #last.
+     */
+    bool fresh;
+    /**
+     * @brief Number of packets decoded.
+     */
+    size_t good;
+    /**
+     * @brief Number of frames dropped.
+     */
+    size_t bad;
+
+    /**
+     * @brief Check the last parsed byte of #frame against the layout.
+     *
+     * @return false if the frame is invalid.
+     */
+    bool valid() const;
+
+    /**
+     * @brief Drop @p count bytes of #frame, then up to the next sync byte,
+     * and parse the rest again.
+     *
+     * @param count Number of bytes.
+     */
+    void discard(size_t count);
+
+    /**
+     * @brief Build #last from the payload.
+     */
+    void finish();
+
+  public:
+    /**
+     * @brief Construct a new PacketDecoder object.
+     */
+    PacketDecoder();
+
+    /**
+     * @brief Drop the partial frame and the counters.
+     */
+    void reset();
+
+    /**
+     * @brief Consume bytes up to the end of the first complete packet.
+     *
+     * @param data Bytes.
+     * @param n Number of bytes.
+     * @return Number of bytes consumed, @p n if no packet was completed.
+     * #ready tells whether a packet was.
+     */
+    size_t decode(const uint8_t* data, size_t n);
+
+    /**
+     * @brief Consume all the bytes, calling @p handler for each packet.
+     *
+     * @param data Bytes.
+     * @param n Number of bytes.
+     * @param handler Packet handler.
+     * @param context Passed to @p handler.
+     * @return Number of packets decoded.
+     */
+    size_t feed(
+        const uint8_t* data,
+        size_t n,
+        PacketHandler handler,
+        void* context);
+
+    /**
+     * @brief Whether the last #decode call completed a packet.
+     *
+     * @return true if #packet is new.
+     */
+    bool ready() const;
+
+    /**
+     * @brief Last decoded packet.
+     *
+     * @return const Packet&
+     */
+    const Packet& packet() const;
+
+    /**
+     * @brief Number of packets decoded.
+     *
+     * @return size_t
+     */
+    size_t packets() const;
+
+    /**
+     * @brief Number of frames dropped (unknown type, bad length or
+     * checksum).
+     *
+     * @return size_t
+     */
+    size_t errors() const;
+};
+
+#endif /* __LIB_CUSTOM_TYPE_PACKET_H__ */
@@ -0,0 +1,163 @@
+/**
+ * @file parallel.cpp
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Work-stealing parallel loop over batch arrays (hosted builds).
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "parallel.h"
+
+size_t ParallelPool::chunkSize(size_t n, size_t parts) {
+    const size_t line { PARALLEL_CACHE_LINE / sizeof(float) };
+    const size_t target { (n + 4 * parts - 1) / (4 * parts) };
+    const size_t c {
+        target > PARALLEL_MIN_CHUNK ? target : PARALLEL_MIN_CHUNK
+    };
+
+    return (c + line - 1) / line * line;
+}
+
+size_t ParallelPool::size() const {
+    return workers;
+}
+
+#if defined(CST_PARALLEL)
+
+ParallelPool::ParallelPool(size_t count) :
+    generation { 0 },
+    busy { 0 },
+    stopping { false },
+    kernel { nullptr },
+    context { nullptr },
+    total { 0 },
+    chunk { 0 },
+    workers { count } {
+    if (workers == 0) {
+        workers = std::thread::hardware_concurrency();
+    }
+    if (workers == 0) {
+        workers = 1;
+    }
+    if (workers > PARALLEL_MAX_WORKERS) {
+        workers = PARALLEL_MAX_WORKERS;
+    }
+
+    for (size_t w {}; w < workers; w++) {
+        runs[w].next.store(0);
+        runs[w].end = 0;
+    }
+    for (size_t w { 1 }; w < workers; w++) {
+        threads[w] = std::thread { &ParallelPool::loop, this, w };
+    }
+}
+
+ParallelPool::~ParallelPool() {
+    {
+        std::lock_guard<std::mutex> guard { stateLock };
+        stopping = true;
+    }
+    wake.notify_all();
+
+    for (size_t w { 1 }; w < workers; w++) {
+        threads[w].join();
+    }
+}
+
+void ParallelPool::work(size_t self) {
+    for (size_t k {}; k < workers; k++) {
+        Run& r { runs[(self + k) % workers] };
+
+        for (;;) {
+            const size_t c { r.next.fetch_add(1, std::memory_order_relaxed) };
+            if (c >= r.end) {
+                break;
+            }
+            const size_t begin { c * chunk };
+            const size_t end { begin + chunk < total ? begin + chunk : total };
+            kernel(context, begin, end);
+        }
+    }
+}
+
+void ParallelPool::loop(size_t self) {
+    unsigned long seen {};
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> guard { stateLock };
+            wake.wait(guard, [&] { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+        }
+
+        work(self);
+
+        std::lock_guard<std::mutex> guard { stateLock };
+        if (--busy == 0) {
+            done.notify_one();
+        }
+    }
+}
+
+void ParallelPool::run(
+    size_t n,
+    ParallelKernel body,
+    void* ctx,
+    size_t grain) {
+    const size_t len { grain > 0 ? grain : chunkSize(n, workers) };
+    if (workers == 1 || n <= len) {
+        body(ctx, 0, n);
+        return;
+    }
+
+    std::lock_guard<std::mutex> serial { loopLock };
+    kernel = body;
+    context = ctx;
+    total = n;
+    chunk = len;
+
+    // contiguous runs of chunks, published by the generation bump below
+    const size_t chunks { (n + chunk - 1) / chunk };
+    for (size_t w {}; w < workers; w++) {
+        runs[w].next.store(w * chunks / workers, std::memory_order_relaxed);
+        runs[w].end = (w + 1) * chunks / workers;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard { stateLock };
+        generation++;
+        busy = workers - 1;
+    }
+    wake.notify_all();
+
+    work(0);
+
+    std::unique_lock<std::mutex> guard { stateLock };
+    done.wait(guard, [&] { return busy == 0; });
+}
+
+#else
+
+ParallelPool::ParallelPool(size_t count) : workers { 1 } {
+    (void)count;
+}
+
+ParallelPool::~ParallelPool() {}
+
+void ParallelPool::run(
+    size_t n,
+    ParallelKernel body,
+    void* ctx,
+    size_t grain) {
+    (void)grain;
+    body(ctx, 0, n);
+}
+
+#endif
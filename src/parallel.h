@@ -0,0 +1,258 @@
+/**
+ * @file parallel.h
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Work-stealing parallel loop over batch arrays (hosted builds).
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef __LIB_CUSTOM_TYPE_PARALLEL_H__
+#define __LIB_CUSTOM_TYPE_PARALLEL_H__
+
+#include <stddef.h>
+#include "def.h"
+#include "arrays.h"
+
+/**
+ * @brief Define CST_PARALLEL on hosted builds (e.g. @c -DCST_PARALLEL
+ * @c -pthread) to run ParallelPool on threads. Without it, and on boards,
+ * every loop runs serially on the caller.
+ */
+#if defined(CST_PARALLEL)
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+/**
+ * @brief Maximum number of workers, the caller included.
+ */
+const size_t PARALLEL_MAX_WORKERS { 64 };
+
+/**
+ * @brief Cache line size (bytes), chunk boundaries fall on it.
+ */
+const size_t PARALLEL_CACHE_LINE { 64 };
+
+/**
+ * @brief Smallest chunk (elements), smaller loops run serially.
+ */
+const size_t PARALLEL_MIN_CHUNK { 1024 };
+
+/**
+ * @brief Loop body: process elements [@p begin, @p end).
+ */
+typedef void (*ParallelKernel)(void* context, size_t begin, size_t end);
+
+/**
+ * @class ParallelPool
+ * @brief Fixed set of worker threads running loops over batch arrays.
+ *
+ * A loop over @c n elements is cut into chunks, a multiple of a cache line
+ * of floats, so two workers never write the same line of an SoA buffer
+ * (for cache-aligned buffers). Each worker owns a contiguous run of chunks
+ * and claims them with an atomic counter; once done, it steals from the
+ * other workers' runs. The caller is worker 0, loops are serialised.
+ *
+ * Batch kernels are independent per element: chunks can be handed to
+ * slices of the arrays, e.g.
+ * @code
+ * pool.forEach(in, [&](const VectorArray& chunk, size_t offset) {
+ *     VectorArray o { out.slice(offset, chunk.length) };
+ *     GravityRemoval::linear(qs.slice(offset, chunk.length), chunk, o);
+ * });
+ * @endcode
+ */
+class ParallelPool {
+  private:
+#if defined(CST_PARALLEL)
+    /**
+     * @brief Run of chunks owned by a worker, one per cache line.
+     */
+    struct alignas(PARALLEL_CACHE_LINE) Run {
+        std::atomic<size_t> next;
+        size_t end;
+    };
+
+    /**
+     * @brief Threads of workers 1 and up.
+     */
+    std::thread threads[PARALLEL_MAX_WORKERS];
+    /**
+     * @brief Chunk runs, one per worker.
+     */
+    Run runs[PARALLEL_MAX_WORKERS];
+    /**
+     * @brief Serialises loops.
+     */
+    std::mutex loopLock;
+    /**
+     * @brief Guards #generation, #busy and #stopping.
+     */
+    std::mutex stateLock;
+    /**
+     * @brief Signals a new loop or #stopping to the workers.
+     */
+    std::condition_variable wake;
+    /**
+     * @brief Signals the end of a loop to the caller.
+     */
+    std::condition_variable done;
+    /**
+     * @brief Loop counter.
+     */
+    unsigned long generation;
+    /**
+     * @brief Workers still running the current loop.
+     */
+    size_t busy;
+    /**
+     * @brief Set by the destructor.
+     */
+    bool stopping;
+    /**
+     * @brief Current loop body.
+     */
+    ParallelKernel kernel;
+    /**
+     * @brief Current loop context.
+     */
+    void* context;
+    /**
+     * @brief Current loop length.
+     */
+    size_t total;
+    /**
+     * @brief Current chunk length.
+     */
+    size_t chunk;
+
+    /**
+     * @brief Run own chunks, then steal.
+     *
+     * @param self Worker index.
+     */
+    void work(size_t self);
+
+    /**
+     * @brief Thread body.
+     *
+     * @param self Worker index.
+     */
+    void loop(size_t self);
+#endif
+
+    /**
+     * @brief Number of workers, the caller included.
+     */
+    size_t workers;
+
+    /**
+     * @brief Adapter calling a functor with an index range.
+     */
+    template <class F>
+    static void invoke(void* f, size_t begin, size_t end) {
+        (*static_cast<const F*>(f))(begin, end);
+    }
+
+    /**
+     * @brief Adapter calling a functor with a slice of an array.
+     */
+    template <class A, class F>
+    struct Slicer {
+        const A& array;
+        const F& f;
+
+        void operator()(size_t begin, size_t end) const {
+            f(array.slice(begin, end - begin), begin);
+        }
+    };
+
+  public:
+    /**
+     * @brief Construct a new ParallelPool object.
+     *
+     * @param count Number of workers, the caller included. 0 uses the
+     * hardware concurrency. Always 1 without CST_PARALLEL.
+     */
+    explicit ParallelPool(size_t count = 0);
+
+    /**
+     * @brief Stop and join the workers.
+     */
+    ~ParallelPool();
+
+    ParallelPool(const ParallelPool&) = delete;
+    ParallelPool& operator=(const ParallelPool&) = delete;
+
+    /**
+     * @brief Number of workers, the caller included.
+     *
+     * @return size_t
+     */
+    size_t size() const;
+
+    /**
+     * @brief Chunk length of a loop: about 4 chunks per worker for load
+     * balance, at least #PARALLEL_MIN_CHUNK, a multiple of a cache line of
+     * floats.
+     *
+     * @param n Loop length.
+     * @param parts Number of workers.
+     * @return size_t
+     */
+    static size_t chunkSize(size_t n, size_t parts);
+
+    /**
+     * @brief Run @p body over [0, @p n) and wait for it.
+     *
+     * @param n Loop length.
+     * @param body Loop body, called concurrently on disjoint ranges.
+     * @param ctx Passed to @p body.
+     * @param grain Chunk length, 0 for #chunkSize. Loops of one chunk run
+     * serially.
+     */
+    void run(size_t n, ParallelKernel body, void* ctx, size_t grain = 0);
+
+    /**
+     * @brief Run a functor @c f(begin,end) over [0, @p n).
+     *
+     * @param n Loop length.
+     * @param f Functor, called concurrently on disjoint ranges.
+     */
+    template <class F>
+    void forEach(size_t n, const F& f) {
+        run(n, &ParallelPool::invoke<F>, const_cast<F*>(&f));
+    }
+
+    /**
+     * @brief Run a functor @c f(chunk,offset) over slices of @p a.
+     *
+     * @param a Vectors.
+     * @param f Functor, called concurrently on disjoint slices.
+     */
+    template <class F>
+    void forEach(const VectorArray& a, const F& f) {
+        const Slicer<VectorArray, F> s { a, f };
+        forEach(a.length, s);
+    }
+
+    /**
+     * @brief Run a functor @c f(chunk,offset) over slices of @p a.
+     *
+     * @param a Quaternions.
+     * @param f Functor, called concurrently on disjoint slices.
+     */
+    template <class F>
+    void forEach(const QuaternionArray& a, const F& f) {
+        const Slicer<QuaternionArray, F> s { a, f };
+        forEach(a.length, s);
+    }
+};
+
+#endif /* __LIB_CUSTOM_TYPE_PARALLEL_H__ */
@@ -0,0 +1,151 @@
+/**
+ * @file pipeline.cpp
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Chunked multi-stage stream processing.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "pipeline.h"
+
+#if defined(CST_PARALLEL)
+#include <chrono>
+#endif
+
+Pipeline::Pipeline() : count { 0 } {
+    clear();
+}
+
+bool Pipeline::addStage(PipelineStage stage, void* context) {
+    if (count == PIPELINE_MAX_STAGES) {
+        return false;
+    }
+
+    stages[count] = stage;
+    contexts[count] = context;
+    stats[count] = PipelineCounters {};
+    count++;
+
+    return true;
+}
+
+void Pipeline::clear() {
+    for (size_t s {}; s < PIPELINE_MAX_STAGES; s++) {
+        stages[s] = nullptr;
+        contexts[s] = nullptr;
+        stats[s] = PipelineCounters {};
+    }
+    count = 0;
+}
+
+size_t Pipeline::size() const {
+    return count;
+}
+
+PipelineCounters Pipeline::counters(size_t s) const {
+    return s < count ? stats[s] : PipelineCounters {};
+}
+
+void Pipeline::process(size_t s, size_t k, size_t n, size_t len) {
+    const size_t begin { k * len };
+    const PipelineChunk chunk {
+        k,
+        k % PIPELINE_SLOTS,
+        begin,
+        begin + len < n ? begin + len : n,
+    };
+
+#if defined(CST_PARALLEL)
+    const std::chrono::steady_clock::time_point start {
+        std::chrono::steady_clock::now()
+    };
+    stages[s](contexts[s], chunk);
+    stats[s].nanoseconds += static_cast<unsigned long long>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count());
+#else
+    stages[s](contexts[s], chunk);
+#endif
+
+    stats[s].chunks++;
+    stats[s].elements += chunk.end - chunk.begin;
+}
+
+#if defined(CST_PARALLEL)
+
+void Pipeline::stageLoop(size_t s, size_t n, size_t len) {
+    const size_t chunks { (n + len - 1) / len };
+    std::atomic<size_t>& last { progress[count - 1].done };
+
+    for (size_t k {}; k < chunks; k++) {
+        // first stage: wait for a free slot; others: wait for the chunk
+        if (s == 0) {
+            while (k - last.load(std::memory_order_acquire)
+                   >= PIPELINE_SLOTS) {
+                std::this_thread::yield();
+            }
+        } else {
+            std::atomic<size_t>& prev { progress[s - 1].done };
+            while (prev.load(std::memory_order_acquire) <= k) {
+                std::this_thread::yield();
+            }
+        }
+
+        process(s, k, n, len);
+        progress[s].done.store(k + 1, std::memory_order_release);
+    }
+}
+
+void Pipeline::run(size_t n, size_t chunk) {
+    for (size_t s {}; s < count; s++) {
+        stats[s] = PipelineCounters {};
+        progress[s].done.store(0, std::memory_order_relaxed);
+    }
+    if (count == 0 || n == 0) {
+        return;
+    }
+
+    const size_t line { PARALLEL_CACHE_LINE / sizeof(float) };
+    const size_t len { chunk > 0 ? (chunk + line - 1) / line * line : line };
+
+    if (count == 1) {
+        stageLoop(0, n, len);
+        return;
+    }
+
+    std::thread threads[PIPELINE_MAX_STAGES];
+    for (size_t s {}; s < count; s++) {
+        threads[s] = std::thread { &Pipeline::stageLoop, this, s, n, len };
+    }
+    for (size_t s {}; s < count; s++) {
+        threads[s].join();
+    }
+}
+
+#else
+
+void Pipeline::run(size_t n, size_t chunk) {
+    for (size_t s {}; s < count; s++) {
+        stats[s] = PipelineCounters {};
+    }
+    if (count == 0 || n == 0) {
+        return;
+    }
+
+    const size_t line { PARALLEL_CACHE_LINE / sizeof(float) };
+    const size_t len { chunk > 0 ? (chunk + line - 1) / line * line : line };
+    const size_t chunks { (n + len - 1) / len };
+
+    for (size_t k {}; k < chunks; k++) {
+        for (size_t s {}; s < count; s++) {
+            process(s, k, n, len);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,230 @@
+/**
+ * @file pipeline.h
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Chunked multi-stage stream processing.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef __LIB_CUSTOM_TYPE_PIPELINE_H__
+#define __LIB_CUSTOM_TYPE_PIPELINE_H__
+
+#include <stddef.h>
+#include "def.h"
+#include "parallel.h"
+
+/**
+ * @brief Maximum number of stages.
+ */
+const size_t PIPELINE_MAX_STAGES { 8 };
+
+/**
+ * @brief Chunks in flight, i.e. capacity of the queues between stages.
+ */
+const size_t PIPELINE_SLOTS { 8 };
+
+/**
+ * @brief Default chunk length (elements): a VectorArray chunk is 12 KiB.
+ */
+const size_t PIPELINE_CHUNK { 1024 };
+
+/**
+ * @brief Chunk handed to a stage.
+ */
+struct PipelineChunk {
+    /**
+     * @brief Chunk number.
+     */
+    size_t index;
+    /**
+     * @brief Buffer slot, @c index modulo #PIPELINE_SLOTS: no two chunks in
+     * flight share it, so stages can stream through slot-sized buffers.
+     */
+    size_t slot;
+    /**
+     * @brief First element.
+     */
+    size_t begin;
+    /**
+     * @brief Element past the last one.
+     */
+    size_t end;
+};
+
+/**
+ * @brief Stage body: process one chunk.
+ */
+typedef void (*PipelineStage)(void* context, const PipelineChunk& chunk);
+
+/**
+ * @brief Throughput counters of a stage.
+ */
+struct PipelineCounters {
+    /**
+     * @brief Processed chunks.
+     */
+    size_t chunks;
+    /**
+     * @brief Processed elements.
+     */
+    size_t elements;
+    /**
+     * @brief Time spent in the stage body (ns), 0 without CST_PARALLEL.
+     */
+    unsigned long long nanoseconds;
+
+    /**
+     * @brief Elements per second of busy time.
+     *
+     * @return 0 if no time was measured.
+     */
+    float throughput() const {
+        return nanoseconds > 0
+            ? static_cast<float>(elements) * 1e9f
+                / static_cast<float>(nanoseconds)
+            : 0.0f;
+    }
+};
+
+/**
+ * @class Pipeline
+ * @brief Chain of stages (parse, calibrate, resample, fuse, ...) run over
+ * chunks in one streaming pass.
+ *
+ * Every stage sees chunk @c k after the previous stage finished it, so each
+ * chunk stays in cache along the chain instead of each stage making a full
+ * pass over memory. Chunks travel in order: the queue between two stages
+ * is a cache-line padded completion counter, bounded by #PIPELINE_SLOTS
+ * chunks in flight (the first stage waits for the last one to retire a
+ * slot). Single producer, single consumer, no locks.
+ *
+ * With CST_PARALLEL each stage runs on its own thread, waiting on its
+ * queue with a yield. Otherwise the chain runs chunk by chunk on the
+ * caller.
+ */
+class Pipeline {
+  private:
+#if defined(CST_PARALLEL)
+    /**
+     * @brief Chunks finished by a stage, one per cache line.
+     */
+    struct alignas(PARALLEL_CACHE_LINE) Progress {
+        std::atomic<size_t> done;
+    };
+
+    /**
+     * @brief Queues, completion counter of each stage.
+     */
+    Progress progress[PIPELINE_MAX_STAGES];
+
+    /**
+     * @brief Thread body of a stage.
+     *
+     * @param s Stage index.
+     * @param n Loop length.
+     * @param len Chunk length.
+     */
+    void stageLoop(size_t s, size_t n, size_t len);
+#endif
+
+    /**
+     * @brief Stage bodies.
+     */
+    PipelineStage stages[PIPELINE_MAX_STAGES];
+    /**
+     * @brief Stage contexts.
+     */
+    void* contexts[PIPELINE_MAX_STAGES];
+    /**
+     * @brief Stage counters.
+     */
+    PipelineCounters stats[PIPELINE_MAX_STAGES];
+    /**
+     * @brief Number of stages.
+     */
+    size_t count;
+
+    /**
+     * @brief Run stage @p s on chunk @p k and update its counters.
+     */
+    void process(size_t s, size_t k, size_t n, size_t len);
+
+    /**
+     * @brief Adapter calling a functor with a chunk.
+     */
+    template <class F>
+    static void invoke(void* f, const PipelineChunk& chunk) {
+        (*static_cast<const F*>(f))(chunk);
+    }
+
+  public:
+    /**
+     * @brief Construct an empty Pipeline object.
+     */
+    Pipeline();
+
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    /**
+     * @brief Append a stage.
+     *
+     * @param stage Stage body.
+     * @param context Passed to @p stage.
+     * @return false if there are already #PIPELINE_MAX_STAGES stages.
+     */
+    bool addStage(PipelineStage stage, void* context);
+
+    /**
+     * @brief Append a functor stage @c f(chunk).
+     *
+     * @param f Functor, must outlive the pipeline runs.
+     * @return false if there are already #PIPELINE_MAX_STAGES stages.
+     */
+    template <class F>
+    bool addStage(const F& f) {
+        return addStage(&Pipeline::invoke<F>, const_cast<F*>(&f));
+    }
+
+    /**
+     * @brief Temporaries are rejected: only the address of the functor is
+     * kept, it would dangle before #run.
+     */
+    template <class F>
+    bool addStage(const F&&) = delete;
+
+    /**
+     * @brief Remove the stages.
+     */
+    void clear();
+
+    /**
+     * @brief Number of stages.
+     *
+     * @return size_t
+     */
+    size_t size() const;
+
+    /**
+     * @brief Stream [0, @p n) through the stages and wait for the end.
+     * Counters are reset first.
+     *
+     * @param n Number of elements.
+     * @param chunk Chunk length, rounded up to a cache line of floats.
+     */
+    void run(size_t n, size_t chunk = PIPELINE_CHUNK);
+
+    /**
+     * @brief Counters of the last run.
+     *
+     * @param s Stage index.
+     * @return PipelineCounters
+     */
+    PipelineCounters counters(size_t s) const;
+};
+
+#endif /* __LIB_CUSTOM_TYPE_PIPELINE_H__ */
@@ -0,0 +1,162 @@
+/**
+ * @file preintegration.cpp
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief IMU preintegration between keyframes.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "preintegration.h"
+
+namespace {
+/**
+ * @brief Arguments of a parallel #Preintegrator::integrateSegments.
+ */
+struct SegmentWork {
+    const VectorArray* gyro;
+    const VectorArray* accel;
+    float dt;
+    const size_t* bounds;
+    Preintegrator* out;
+};
+
+/**
+ * @brief Integrate segments [@p begin, @p end).
+ *
+ * @param w SegmentWork.
+ * @param begin First segment.
+ * @param end Segment past the last one.
+ */
+void segmentKernel(void* w, size_t begin, size_t end) {
+    const SegmentWork& work { *static_cast<const SegmentWork*>(w) };
+    Preintegrator::integrateSegments(
+        *work.gyro,
+        *work.accel,
+        work.dt,
+        work.bounds + begin,
+        end - begin,
+        work.out + begin);
+}
+}  // namespace
+
+Preintegrator::Preintegrator(const Vector& gb, const Vector& ab) :
+    rotation {},
+    velocity {},
+    position {},
+    elapsed { 0.0f },
+    gyroBias { gb },
+    accelBias { ab } {}
+
+void Preintegrator::integrateSegments(
+    const VectorArray& gyro,
+    const VectorArray& accel,
+    float dt,
+    const size_t bounds[],
+    size_t segments,
+    Preintegrator out[]) {
+    for (size_t s {}; s < segments; s++) {
+        for (size_t i { bounds[s] }; i < bounds[s + 1]; i++) {
+            out[s].integrate(gyro.get(i), accel.get(i), dt);
+        }
+    }
+}
+
+void Preintegrator::integrateSegments(
+    ParallelPool& pool,
+    const VectorArray& gyro,
+    const VectorArray& accel,
+    float dt,
+    const size_t bounds[],
+    size_t segments,
+    Preintegrator out[]) {
+    SegmentWork work { &gyro, &accel, dt, bounds, out };
+    pool.run(segments, segmentKernel, &work, 1);
+}
+
+void Preintegrator::reset(const Vector& gb, const Vector& ab) {
+    *this = Preintegrator { gb, ab };
+}
+
+void Preintegrator::integrate(
+    const Vector& gyro,
+    const Vector& accel,
+    float dt) {
+    const Vector w { gyro - gyroBias };
+    const Vector a { accel - accelBias };
+    const Vector phi { w * dt };
+    const float halfDt2 { 0.5f * dt * dt };
+
+    const Quaternion step { Quaternion::fromRotationVector(phi) };
+    const Matrix3x3 r { rotation.toRotationMatrix() };
+    const Vector ra { r * a };
+    const Matrix3x3 raSkew { r * Matrix3x3::skew(a) };
+    const Matrix3x3 raSkewdR { raSkew * dRdBg };
+
+    // Jacobians first, they use the rotation before this step
+    dPdBa += dVdBa * dt - r * halfDt2;
+    dPdBg += dVdBg * dt - raSkewdR * halfDt2;
+    dVdBa -= r * dt;
+    dVdBg -= raSkewdR * dt;
+
+    // right Jacobian of SO(3), first order in the small step angle
+    const Matrix3x3 jr { Matrix3x3::identity() - Matrix3x3::skew(phi * 0.5f) };
+    dRdBg = step.conjugate().toRotationMatrix() * dRdBg - jr * dt;
+
+    position += velocity * dt + ra * halfDt2;
+    velocity += ra * dt;
+    rotation *= step;
+    rotation.normalize();
+    elapsed += dt;
+}
+
+float Preintegrator::deltaTime() const {
+    return elapsed;
+}
+
+Quaternion Preintegrator::deltaRotation() const {
+    return rotation;
+}
+
+Vector Preintegrator::deltaVelocity() const {
+    return velocity;
+}
+
+Vector Preintegrator::deltaPosition() const {
+    return position;
+}
+
+Quaternion Preintegrator::deltaRotation(const Vector& gb) const {
+    return rotation * Quaternion::fromRotationVector(dRdBg * (gb - gyroBias));
+}
+
+Vector Preintegrator::deltaVelocity(const Vector& gb, const Vector& ab) const {
+    return velocity + dVdBg * (gb - gyroBias) + dVdBa * (ab - accelBias);
+}
+
+Vector Preintegrator::deltaPosition(const Vector& gb, const Vector& ab) const {
+    return position + dPdBg * (gb - gyroBias) + dPdBa * (ab - accelBias);
+}
+
+Matrix3x3 Preintegrator::rotationByGyroBias() const {
+    return dRdBg;
+}
+
+Matrix3x3 Preintegrator::velocityByGyroBias() const {
+    return dVdBg;
+}
+
+Matrix3x3 Preintegrator::velocityByAccelBias() const {
+    return dVdBa;
+}
+
+Matrix3x3 Preintegrator::positionByGyroBias() const {
+    return dPdBg;
+}
+
+Matrix3x3 Preintegrator::positionByAccelBias() const {
+    return dPdBa;
+}
@@ -0,0 +1,246 @@
+/**
+ * @file preintegration.h
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief IMU preintegration between keyframes.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef __LIB_CUSTOM_TYPE_PREINTEGRATION_H__
+#define __LIB_CUSTOM_TYPE_PREINTEGRATION_H__
+
+#include <stddef.h>
+#include "def.h"
+#include "vector.h"
+#include "quaternion.h"
+#include "matrix.h"
+#include "arrays.h"
+#include "parallel.h"
+
+/**
+ * @class Preintegrator
+ * @brief Accumulates the relative motion @f$\Delta R,\Delta v,\Delta p@f$
+ * between two keyframes from raw gyro/accel samples, along with the
+ * first-order Jacobians with respect to the gyro and accel biases.
+ *
+ * Biases are linearised at the values given on #reset. A later bias
+ * estimate is folded in with the Jacobians in O(1) (see the corrected
+ * accessors), without re-integrating the samples. No heap is used.
+ */
+class Preintegrator {
+  private:
+    /**
+     * @brief Preintegrated rotation.
+     */
+    Quaternion rotation;
+    /**
+     * @brief Preintegrated velocity.
+     */
+    Vector velocity;
+    /**
+     * @brief Preintegrated position.
+     */
+    Vector position;
+    /**
+     * @brief Integrated time.
+     */
+    float elapsed;
+
+    /**
+     * @brief Gyro bias linearisation point.
+     */
+    Vector gyroBias;
+    /**
+     * @brief Accel bias linearisation point.
+     */
+    Vector accelBias;
+
+    /**
+     * @brief @f$\partial\Delta R/\partial b_g@f$ (tangent space).
+     */
+    Matrix3x3 dRdBg;
+    /**
+     * @brief @f$\partial\Delta v/\partial b_g@f$.
+     */
+    Matrix3x3 dVdBg;
+    /**
+     * @brief @f$\partial\Delta v/\partial b_a@f$.
+     */
+    Matrix3x3 dVdBa;
+    /**
+     * @brief @f$\partial\Delta p/\partial b_g@f$.
+     */
+    Matrix3x3 dPdBg;
+    /**
+     * @brief @f$\partial\Delta p/\partial b_a@f$.
+     */
+    Matrix3x3 dPdBa;
+
+  public:
+    /**
+     * @brief Construct a new Preintegrator object.
+     *
+     * @param gb Gyro bias linearisation point.
+     * @param ab Accel bias linearisation point.
+     */
+    explicit Preintegrator(
+        const Vector& gb = Vector {},
+        const Vector& ab = Vector {});
+
+    /**
+     * @brief Batch preintegration of consecutive segments of one log.
+     *
+     * Segment @f$s@f$ covers samples @f$[bounds_s,bounds_{s+1})@f$ and is
+     * accumulated into @p out[s] from its current state (reset it first to
+     * set the biases). Segments are independent, see the ParallelPool
+     * overload to spread them over threads.
+     *
+     * @param gyro Angular rates (rad/s).
+     * @param accel Specific forces (m/s^2).
+     * @param dt Sample period (seconds).
+     * @param bounds @p segments + 1 sample indices.
+     * @param segments Number of segments.
+     * @param out One preintegrator per segment.
+     */
+    static void integrateSegments(
+        const VectorArray& gyro,
+        const VectorArray& accel,
+        float dt,
+        const size_t bounds[],
+        size_t segments,
+        Preintegrator out[]);
+
+    /**
+     * @brief Batch preintegration of consecutive segments of one log on a
+     * ParallelPool. Workers claim one segment at a time, so segments of
+     * different lengths balance; the result matches the serial overload.
+     *
+     * @param pool Workers.
+     * @param gyro Angular rates (rad/s).
+     * @param accel Specific forces (m/s^2).
+     * @param dt Sample period (seconds).
+     * @param bounds @p segments + 1 sample indices.
+     * @param segments Number of segments.
+     * @param out One preintegrator per segment.
+     */
+    static void integrateSegments(
+        ParallelPool& pool,
+        const VectorArray& gyro,
+        const VectorArray& accel,
+        float dt,
+        const size_t bounds[],
+        size_t segments,
+        Preintegrator out[]);
+
+    /**
+     * @brief Start a new interval.
+     *
+     * @param gb Gyro bias linearisation point.
+     * @param ab Accel bias linearisation point.
+     */
+    void reset(const Vector& gb = Vector {}, const Vector& ab = Vector {});
+
+    /**
+     * @brief Add one IMU sample.
+     *
+     * @param gyro Angular rate (rad/s).
+     * @param accel Specific force (m/s^2).
+     * @param dt Sample period (seconds).
+     */
+    void integrate(const Vector& gyro, const Vector& accel, float dt);
+
+    /**
+     * @brief Integrated time.
+     *
+     * @return float
+     */
+    float deltaTime() const;
+
+    /**
+     * @brief Preintegrated rotation at the linearisation point.
+     *
+     * @return Quaternion
+     */
+    Quaternion deltaRotation() const;
+
+    /**
+     * @brief Preintegrated velocity at the linearisation point.
+     *
+     * @return Vector
+     */
+    Vector deltaVelocity() const;
+
+    /**
+     * @brief Preintegrated position at the linearisation point.
+     *
+     * @return Vector
+     */
+    Vector deltaPosition() const;
+
+    /**
+     * @brief Preintegrated rotation corrected for a new gyro bias.
+     *
+     * @param gb Gyro bias estimate.
+     * @return Quaternion
+     */
+    Quaternion deltaRotation(const Vector& gb) const;
+
+    /**
+     * @brief Preintegrated velocity corrected for new biases.
+     *
+     * @param gb Gyro bias estimate.
+     * @param ab Accel bias estimate.
+     * @return Vector
+     */
+    Vector deltaVelocity(const Vector& gb, const Vector& ab) const;
+
+    /**
+     * @brief Preintegrated position corrected for new biases.
+     *
+     * @param gb Gyro bias estimate.
+     * @param ab Accel bias estimate.
+     * @return Vector
+     */
+    Vector deltaPosition(const Vector& gb, const Vector& ab) const;
+
+    /**
+     * @brief Jacobian of the rotation w.r.t. the gyro bias.
+     *
+     * @return Matrix3x3
+     */
+    Matrix3x3 rotationByGyroBias() const;
+
+    /**
+     * @brief Jacobian of the velocity w.r.t. the gyro bias.
+     *
+     * @return Matrix3x3
+     */
+    Matrix3x3 velocityByGyroBias() const;
+
+    /**
+     * @brief Jacobian of the velocity w.r.t. the accel bias.
+     *
+     * @return Matrix3x3
+     */
+    Matrix3x3 velocityByAccelBias() const;
+
+    /**
+     * @brief Jacobian of the position w.r.t. the gyro bias.
+     *
+     * @return Matrix3x3
+     */
+    Matrix3x3 positionByGyroBias() const;
+
+    /**
+     * @brief Jacobian of the position w.r.t. the accel bias.
+     *
+     * @return Matrix3x3
+     */
+    Matrix3x3 positionByAccelBias() const;
+};
+
+#endif /* __LIB_CUSTOM_TYPE_PREINTEGRATION_H__ */
@@ -12,6 +12,8 @@
 
 #include "quaternion.h"
 
+#include "arrays.h"
+
 Quaternion::Quaternion(float a, float b, float c, float d) :
     w { a },
     x { b },
@@ -38,6 +40,72 @@ float Quaternion::angle(bool inDegrees) {
     return 2.0f * acosf(w);
 }
 
+Quaternion Quaternion::slerp(
+    const Quaternion& a,
+    const Quaternion& b,
+    float t) {
+    const float d { a.dot(b) };
+    const float c { fabsf(d) };
+
+    if (c > 0.9995f) {
+        return nlerp(a, b, t);
+    }
+
+    const float theta { acosf(c) };
+    const float inv { 1.0f / sinf(theta) };
+    const float ta { sinf((1.0f - t) * theta) * inv };
+    const float tb { (d < 0.0f ? -inv : inv) * sinf(t * theta) };
+
+    return Quaternion {
+        ta * a.w + tb * b.w,
+        ta * a.x + tb * b.x,
+        ta * a.y + tb * b.y,
+        ta * a.z + tb * b.z,
+    };
+}
+
+Quaternion Quaternion::squadControl(
+    const Quaternion& prev,
+    const Quaternion& cur,
+    const Quaternion& next) {
+    const Quaternion inv { cur.conjugate() };
+    const Vector l {
+        (inv * next).toRotationVector() + (inv * prev).toRotationVector()
+    };
+
+    // log is half the rotation vector: exp(-(l / 2) / 4)
+    return (cur * fromRotationVector(l * -0.25f)).normalised();
+}
+
+Quaternion Quaternion::squad(
+    const Quaternion& a,
+    const Quaternion& b,
+    const Quaternion& sa,
+    const Quaternion& sb,
+    float t) {
+    return slerp(slerp(a, b, t), slerp(sa, sb, t), 2.0f * t * (1.0f - t));
+}
+
+Vector Quaternion::toRotationVector() const {
+    // shortest path: q and -q are the same rotation
+    const float sw { w < 0.0f ? -1.0f : 1.0f };
+    const float s2 { x * x + y * y + z * z };
+    const float c { sw * w };
+    float k;
+
+    if (s2 < 1e-6f) {
+        // 2 atan(s / c) / s, first terms of the series
+        k = 2.0f / c * (1.0f - s2 / (3.0f * c * c));
+    } else {
+        const float s { sqrtf(s2) };
+        k = 2.0f * atan2f(s, c) / s;
+    }
+
+    k *= sw;
+
+    return Vector { k * x, k * y, k * z };
+}
+
 Vector Quaternion::axis() const {
     return Vector {
         x,
@@ -59,6 +127,89 @@ Quaternion Quaternion::conjugate() const {
     };
 }
 
+float Quaternion::dot(const Quaternion& rhs) const {
+    return w * rhs.w + x * rhs.x + y * rhs.y + z * rhs.z;
+}
+
+Vector Quaternion::rotate(const Vector& v) const {
+    // t = 2 (u x v), v' = v + w t + u x t
+    const float tx { 2.0f * (y * v.z - z * v.y) };
+    const float ty { 2.0f * (z * v.x - x * v.z) };
+    const float tz { 2.0f * (x * v.y - y * v.x) };
+
+    return Vector {
+        v.x + w * tx + (y * tz - z * ty),
+        v.y + w * ty + (z * tx - x * tz),
+        v.z + w * tz + (x * ty - y * tx),
+    };
+}
+
+void Quaternion::swingTwist(
+    const Vector& axis,
+    Quaternion& swing,
+    Quaternion& twist) const {
+    const float d { x * axis.x + y * axis.y + z * axis.z };
+    twist = Quaternion { w, d * axis.x, d * axis.y, d * axis.z };
+
+    const float n2 { cst::sqr(w) + cst::sqr(d) };
+    if (n2 < cst::EPSILON) {
+        // half-turn swing, the twist is undefined
+        twist = Quaternion {};
+    } else {
+        twist /= sqrtf(n2);
+    }
+
+    swing = *this * twist.conjugate();
+}
+
+void Quaternion::swingTwist(
+    const QuaternionArray& qs,
+    const Vector& axis,
+    QuaternionArray& swings,
+    QuaternionArray& twists) {
+    const float* CST_RESTRICT qw { qs.w };
+    const float* CST_RESTRICT qx { qs.x };
+    const float* CST_RESTRICT qy { qs.y };
+    const float* CST_RESTRICT qz { qs.z };
+    float* CST_RESTRICT sw { swings.w };
+    float* CST_RESTRICT sx { swings.x };
+    float* CST_RESTRICT sy { swings.y };
+    float* CST_RESTRICT sz { swings.z };
+    float* CST_RESTRICT tw { twists.w };
+    float* CST_RESTRICT tx { twists.x };
+    float* CST_RESTRICT ty { twists.y };
+    float* CST_RESTRICT tz { twists.z };
+    const float ax { axis.x };
+    const float ay { axis.y };
+    const float az { axis.z };
+    const size_t n { qs.length };
+
+    CST_IVDEP
+    for (size_t i {}; i < n; i++) {
+        const float d { qx[i] * ax + qy[i] * ay + qz[i] * az };
+        const float n2 { cst::sqr(qw[i]) + cst::sqr(d) };
+        // selects instead of a branch keep the loop vectorisable
+        const bool valid { n2 >= cst::EPSILON };
+        const float inv { valid ? 1.0f / sqrtf(valid ? n2 : 1.0f) : 0.0f };
+        const float a { valid ? qw[i] * inv : 1.0f };
+        const float b { d * inv };
+        const float bx { b * ax };
+        const float by { b * ay };
+        const float bz { b * az };
+
+        tw[i] = a;
+        tx[i] = bx;
+        ty[i] = by;
+        tz[i] = bz;
+
+        // swing = q * conj(twist)
+        sw[i] = qw[i] * a + qx[i] * bx + qy[i] * by + qz[i] * bz;
+        sx[i] = qx[i] * a - qw[i] * bx - qy[i] * bz + qz[i] * by;
+        sy[i] = qy[i] * a - qw[i] * by - qz[i] * bx + qx[i] * bz;
+        sz[i] = qz[i] * a - qw[i] * bz - qx[i] * by + qy[i] * bx;
+    }
+}
+
 Quaternion Quaternion::operator/(float n) const {
     return Quaternion {
         w / n,
@@ -170,15 +321,15 @@ void Quaternion::clear() {
 // }
 
 Matrix3x3 Quaternion::toRotationMatrix() const {
-    const float twx = x * w;
-    const float twy = y * w;
-    const float twz = z * w;
-    const float txx = cst::sqr(x);
-    const float txy = y * x;
-    const float txz = z * x;
-    const float tyy = cst::sqr(y);
-    const float tyz = z * y;
-    const float tzz = cst::sqr(z);
+    const float twx = 2.0f * x * w;
+    const float twy = 2.0f * y * w;
+    const float twz = 2.0f * z * w;
+    const float txx = 2.0f * cst::sqr(x);
+    const float txy = 2.0f * y * x;
+    const float txz = 2.0f * z * x;
+    const float tyy = 2.0f * cst::sqr(y);
+    const float tyz = 2.0f * z * y;
+    const float tzz = 2.0f * cst::sqr(z);
 
     const float a00 = 1.0f - (tyy + tzz);
     const float a01 = txy - twz;
@@ -18,6 +18,10 @@
 #include "vector.h"
 #include "matrix.h"
 
+// to avoid cyclic dependencies.
+// The header is included in the source file.
+class QuaternionArray;
+
 /**
  * @class Quaternion
  * @brief Creates a quaternion representation.
@@ -89,6 +93,53 @@ class Quaternion {
      */
     Quaternion conjugate() const;
 
+    /**
+     * @brief Computes the dot product of 2 quaternions.
+     *
+     * @param rhs Quaternion.
+     * @return Dot product.
+     */
+    float dot(const Quaternion& rhs) const;
+
+    /**
+     * @brief Rotates a vector by the quaternion (assumed unit),
+     *  @f$q\,v\,q^{*}@f$ without forming the Hamilton products.
+     *
+     * @param v #Vector.
+     * @return Rotated #Vector.
+     */
+    Vector rotate(const Vector& v) const;
+
+    /**
+     * @brief Swing-twist decomposition about @p axis,
+     *  @f$q=swing\cdot twist@f$.
+     *
+     * Trig-free with a single normalisation: the twist is the projection of
+     * the quaternion on @p axis, the swing is what remains. When the swing is
+     * a half turn (@f$w=0@f$ and the vector part orthogonal to @p axis) the
+     * twist is undefined and set to identity.
+     *
+     * @param axis Unit twist axis.
+     * @param swing Rotation orthogonal to @p axis.
+     * @param twist Rotation about @p axis.
+     */
+    void swingTwist(const Vector& axis, Quaternion& swing, Quaternion& twist)
+        const;
+
+    /**
+     * @brief Batch swing-twist decomposition about a common @p axis.
+     *
+     * @param qs Unit quaternions.
+     * @param axis Unit twist axis.
+     * @param swings Swing parts, same length as @p qs.
+     * @param twists Twist parts, same length as @p qs.
+     */
+    static void swingTwist(
+        const QuaternionArray& qs,
+        const Vector& axis,
+        QuaternionArray& swings,
+        QuaternionArray& twists);
+
     /**
      * @brief Create quaternion from angles.
      *
@@ -119,6 +170,141 @@ class Quaternion {
         };
     }
 
+    /**
+     * @brief Create the shortest-arc rotation taking @p from onto @p to.
+     * Trig-free: @f$q=\left(|a||b|+a\cdot b,\;a\times b\right)@f$
+     * normalised. Opposite vectors give a half turn about an axis orthogonal
+     * to @p from.
+     *
+     * @param from Start direction, not necessarily unit.
+     * @param to End direction, not necessarily unit.
+     * @return Unit quaternion.
+     */
+    static Quaternion fromTwoVectors(const Vector& from, const Vector& to) {
+        const float n { sqrtf(from.normSqr() * to.normSqr()) };
+        const float w { n + from.dot(to) };
+
+        if (w <= cst::EPSILON * n) {
+            // half turn, any axis orthogonal to from
+            const Vector axis {
+                fabsf(from.x) > fabsf(from.z)
+                    ? Vector { -from.y, from.x, 0.0f }
+                    : Vector { 0.0f, -from.z, from.y }
+            };
+
+            return Quaternion { 0.0f, axis.x, axis.y, axis.z }.normalised();
+        }
+
+        const Vector c { from.cross(to) };
+
+        return Quaternion { w, c.x, c.y, c.z }.normalised();
+    }
+
+    /**
+     * @brief Create quaternion from a rotation vector (axis times angle),
+     *  @f$q=\exp\left(\phi/2\right)@f$.
+     * Small angles, the common case for high-rate integration, use a
+     * trig-free series.
+     *
+     * @param phi Rotation vector (radians).
+     * @return Unit quaternion.
+     */
+    static Quaternion fromRotationVector(const Vector& phi) {
+        const Vector h { phi * 0.5f };
+        const float n2 { h.normSqr() };
+
+        if (n2 < 1e-2f) {
+            // exp truncated after the 4th order terms
+            const float c { 1.0f - n2 * (0.5f - n2 * (1.0f / 24.0f)) };
+            const float s {
+                1.0f - n2 * ((1.0f / 6.0f) - n2 * (1.0f / 120.0f))
+            };
+
+            return Quaternion { c, s * h.x, s * h.y, s * h.z };
+        }
+
+        const float n { sqrtf(n2) };
+        const float s { sinf(n) / n };
+
+        return Quaternion { cosf(n), s * h.x, s * h.y, s * h.z };
+    }
+
+    /**
+     * @brief Normalised linear interpolation, along the shortest path.
+     * Trig-free alternative to slerp for small steps and blending.
+     *
+     * @param a Start quaternion (@p t = 0).
+     * @param b End quaternion (@p t = 1).
+     * @param t Interpolation factor.
+     * @return Unit quaternion.
+     */
+    static Quaternion nlerp(const Quaternion& a, const Quaternion& b, float t) {
+        const float tb { a.dot(b) < 0.0f ? -t : t };
+        const float ta { 1.0f - t };
+
+        const Quaternion q {
+            ta * a.w + tb * b.w,
+            ta * a.x + tb * b.x,
+            ta * a.y + tb * b.y,
+            ta * a.z + tb * b.z,
+        };
+
+        return q.normalised();
+    }
+
+    /**
+     * @brief Spherical linear interpolation, along the shortest path.
+     * Falls back to #nlerp when the quaternions are nearly parallel.
+     *
+     * @param a Start quaternion (@p t = 0).
+     * @param b End quaternion (@p t = 1).
+     * @param t Interpolation factor.
+     * @return Unit quaternion.
+     */
+    static Quaternion slerp(const Quaternion& a, const Quaternion& b, float t);
+
+    /**
+     * @brief Inner control point of a squad segment at @p cur,
+     *  @f$s=q\exp\left(-\frac{\log(q^{-1}q_{+})+\log(q^{-1}q_{-})}{4}
+     *  \right)@f$.
+     *
+     * @param prev Previous key.
+     * @param cur Current key.
+     * @param next Next key.
+     * @return Unit quaternion.
+     */
+    static Quaternion squadControl(
+        const Quaternion& prev,
+        const Quaternion& cur,
+        const Quaternion& next);
+
+    /**
+     * @brief Spherical quadrangle interpolation between @p a and @p b,
+     * C1-continuous across keys.
+     *
+     * @param a Start key (@p t = 0).
+     * @param b End key (@p t = 1).
+     * @param sa Control point of @p a (#squadControl).
+     * @param sb Control point of @p b.
+     * @param t Interpolation factor.
+     * @return Unit quaternion.
+     */
+    static Quaternion squad(
+        const Quaternion& a,
+        const Quaternion& b,
+        const Quaternion& sa,
+        const Quaternion& sb,
+        float t);
+
+    /**
+     * @brief Rotation vector (axis times angle) of a unit quaternion,
+     *  @f$\phi=2\log(q)@f$, taken along the shortest path. Small angles use
+     *  a series instead of the arc tangent.
+     *
+     * @return Rotation vector (radians).
+     */
+    Vector toRotationVector() const;
+
     /**
      * @brief Clear content.
      * Sets the quaternion to a unit quaternion.
@@ -0,0 +1,85 @@
+/**
+ * @file rawvector.cpp
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Raw sensor counts and their conversion to calibrated units.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "rawvector.h"
+
+static_assert(
+    sizeof(RawVector3i16) == 3 * sizeof(int16_t),
+    "RawVector3i16 must match the sensor layout");
+
+RawVector3i16::RawVector3i16(int16_t a, int16_t b, int16_t c) :
+    x { a },
+    y { b },
+    z { c } {}
+
+Vector RawVector3i16::toVector(float scale) const {
+    return Vector {
+        scale * static_cast<float>(x),
+        scale * static_cast<float>(y),
+        scale * static_cast<float>(z),
+    };
+}
+
+RawConverter::RawConverter(
+    float scale,
+    const Vector& bias,
+    const Matrix3x3& m,
+    const Quaternion& rotation) :
+    gain {},
+    offset {} {
+    configure(scale, bias, m, rotation);
+}
+
+void RawConverter::configure(
+    float scale,
+    const Vector& bias,
+    const Matrix3x3& m,
+    const Quaternion& rotation) {
+    const Matrix3x3 rm { rotation.toRotationMatrix() * m };
+
+    gain = rm * scale;
+    offset = rm * bias;
+}
+
+Vector RawConverter::convert(const RawVector3i16& raw) const {
+    return gain * raw.toVector() - offset;
+}
+
+void RawConverter::convert(const RawVector3i16* raw, VectorArray& out) const {
+    const RawVector3i16* CST_RESTRICT in { raw };
+    float* CST_RESTRICT ox { out.x };
+    float* CST_RESTRICT oy { out.y };
+    float* CST_RESTRICT oz { out.z };
+    const float k11 { gain.coeff(0, 0) };
+    const float k12 { gain.coeff(0, 1) };
+    const float k13 { gain.coeff(0, 2) };
+    const float k21 { gain.coeff(1, 0) };
+    const float k22 { gain.coeff(1, 1) };
+    const float k23 { gain.coeff(1, 2) };
+    const float k31 { gain.coeff(2, 0) };
+    const float k32 { gain.coeff(2, 1) };
+    const float k33 { gain.coeff(2, 2) };
+    const float cx { offset.x };
+    const float cy { offset.y };
+    const float cz { offset.z };
+    const size_t n { out.length };
+
+    CST_IVDEP
+    for (size_t i {}; i < n; i++) {
+        const float x { static_cast<float>(in[i].x) };
+        const float y { static_cast<float>(in[i].y) };
+        const float z { static_cast<float>(in[i].z) };
+        ox[i] = k11 * x + k12 * y + k13 * z - cx;
+        oy[i] = k21 * x + k22 * y + k23 * z - cy;
+        oz[i] = k31 * x + k32 * y + k33 * z - cz;
+    }
+}
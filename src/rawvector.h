@@ -0,0 +1,131 @@
+/**
+ * @file rawvector.h
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Raw sensor counts and their conversion to calibrated units.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef __LIB_CUSTOM_TYPE_RAWVECTOR_H__
+#define __LIB_CUSTOM_TYPE_RAWVECTOR_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "def.h"
+#include "vector.h"
+#include "quaternion.h"
+#include "matrix.h"
+#include "arrays.h"
+
+/**
+ * @class RawVector3i16
+ * @brief Raw 16-bit sensor triple, laid out as the sensor delivers it (x, y,
+ * z, 6 bytes, no padding) so that a DMA buffer can be read in place.
+ */
+class RawVector3i16 {
+  public:
+    /**
+     * @brief Count along x-axis.
+     */
+    int16_t x;
+    /**
+     * @brief Count along y-axis.
+     */
+    int16_t y;
+    /**
+     * @brief Count along z-axis.
+     */
+    int16_t z;
+
+    /**
+     * @brief Construct a new RawVector3i16 object.
+     *
+     * @param a x-axis count, defaults to 0.
+     * @param b y-axis count, defaults to 0.
+     * @param c z-axis count, defaults to 0.
+     */
+    explicit RawVector3i16(int16_t a = 0, int16_t b = 0, int16_t c = 0);
+
+    /**
+     * @brief Convert to a Vector.
+     *
+     * @param scale Physical unit per count.
+     * @return Vector
+     */
+    Vector toVector(float scale = 1.0f) const;
+};
+
+/**
+ * @class RawConverter
+ * @brief Fused conversion from raw counts to calibrated units:
+ * @f$v=R\,M\,(s\,r-b)@f$, with the count scale @f$s@f$, the bias @f$b@f$,
+ * the misalignment/scale matrix @f$M@f$ and an optional sensor to body
+ * rotation @f$R@f$.
+ *
+ * The chain is folded once into an affine map @f$v=Kr-c@f$
+ * (@f$K=sRM@f$, @f$c=RMb@f$), so a sample costs 9 multiplies and 9 adds
+ * and no intermediate Vector is built.
+ */
+class RawConverter {
+  private:
+    /**
+     * @brief Folded gain @f$K@f$.
+     */
+    Matrix3x3 gain;
+    /**
+     * @brief Folded offset @f$c@f$.
+     */
+    Vector offset;
+
+  public:
+    /**
+     * @brief Construct a new RawConverter object.
+     *
+     * @param scale Physical unit per count.
+     * @param bias Bias, in physical units.
+     * @param m Misalignment/scale correction.
+     * @param rotation Sensor to body rotation.
+     */
+    explicit RawConverter(
+        float scale = 1.0f,
+        const Vector& bias = Vector {},
+        const Matrix3x3& m = Matrix3x3::identity(),
+        const Quaternion& rotation = Quaternion {});
+
+    /**
+     * @brief Set the calibration and fold it.
+     *
+     * @param scale Physical unit per count.
+     * @param bias Bias, in physical units.
+     * @param m Misalignment/scale correction.
+     * @param rotation Sensor to body rotation.
+     */
+    void configure(
+        float scale,
+        const Vector& bias,
+        const Matrix3x3& m,
+        const Quaternion& rotation = Quaternion {});
+
+    /**
+     * @brief Convert one sample.
+     *
+     * @param raw Raw counts.
+     * @return Calibrated Vector.
+     */
+    Vector convert(const RawVector3i16& raw) const;
+
+    /**
+     * @brief Convert a burst in one pass (int16 to float, bias, matrix,
+     * rotation).
+     *
+     * @param raw Raw samples, at least @p out.length of them.
+     * @param out Calibrated samples.
+     */
+    void convert(const RawVector3i16* raw, VectorArray& out) const;
+};
+
+#endif /* __LIB_CUSTOM_TYPE_RAWVECTOR_H__ */
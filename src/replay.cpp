@@ -0,0 +1,175 @@
+/**
+ * @file replay.cpp
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Parallel replay of recorded logs with per-log metrics.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "replay.h"
+
+#if defined(CST_PARALLEL)
+#include <chrono>
+#endif
+
+namespace {
+/**
+ * @brief State shared by the workers of a run.
+ */
+struct ReplayWork {
+    ReplayJob* jobs;
+    size_t count;
+    ReplayFunction replay;
+    void* context;
+#if defined(CST_PARALLEL)
+    std::atomic<size_t> next;
+#else
+    size_t next;
+#endif
+};
+
+/**
+ * @brief Worker body: claim jobs in order until none is left.
+ *
+ * @param w ReplayWork.
+ * @param begin Unused, one call per worker.
+ * @param end Unused.
+ */
+void replayWorker(void* w, size_t begin, size_t end) {
+    (void)begin;
+    (void)end;
+    ReplayWork& work { *static_cast<ReplayWork*>(w) };
+
+    for (;;) {
+        const size_t j { work.next++ };
+        if (j >= work.count) {
+            return;
+        }
+        work.replay(work.context, work.jobs[j]);
+    }
+}
+
+/**
+ * @brief Samples replayed by a job.
+ *
+ * @param job Job.
+ * @return size_t
+ */
+inline size_t cost(const ReplayJob& job) {
+    return job.end - job.start;
+}
+}  // namespace
+
+ReplayScheduler::ReplayScheduler(ReplayJob* buffer, size_t size) :
+    jobs { buffer },
+    capacity { size },
+    count { 0 },
+    logs { 0 },
+    segment { 0 },
+    warmup { 0 } {}
+
+void ReplayScheduler::setSplit(size_t length, size_t overlap) {
+    segment = length;
+    warmup = overlap;
+}
+
+size_t ReplayScheduler::plan(
+    const size_t* lengths,
+    const bool* splittable,
+    size_t n) {
+    count = 0;
+    logs = 0;
+
+    for (size_t l {}; l < n; l++) {
+        const size_t len { lengths[l] };
+        const bool split {
+            segment > 0 && splittable != nullptr && splittable[l]
+        };
+        const size_t step { split ? segment : (len > 0 ? len : 1) };
+
+        for (size_t b {}; b < len; b += step) {
+            if (count == capacity) {
+                count = 0;
+                return 0;
+            }
+            ReplayJob& job { jobs[count++] };
+            job.log = l;
+            job.begin = b;
+            job.start = b > warmup ? b - warmup : 0;
+            job.end = len - b > step ? b + step : len;
+            job.metrics = ReplayMetrics {};
+        }
+    }
+    logs = n;
+
+    // longest first (Shell sort, no allocation)
+    size_t gap { 1 };
+    while (gap < count / 3) {
+        gap = 3 * gap + 1;
+    }
+    for (; gap > 0; gap /= 3) {
+        for (size_t i { gap }; i < count; i++) {
+            const ReplayJob job { jobs[i] };
+            size_t k { i };
+            for (; k >= gap && cost(jobs[k - gap]) < cost(job); k -= gap) {
+                jobs[k] = jobs[k - gap];
+            }
+            jobs[k] = job;
+        }
+    }
+
+    return count;
+}
+
+const ReplayJob* ReplayScheduler::planned() const {
+    return jobs;
+}
+
+ReplayReport ReplayScheduler::run(
+    ParallelPool& pool,
+    ReplayFunction replay,
+    void* context,
+    ReplayMetrics* perLog) {
+    ReplayReport report {};
+    report.logs = logs;
+    report.jobs = count;
+    report.workers = pool.size();
+
+    ReplayWork work;
+    work.jobs = jobs;
+    work.count = count;
+    work.replay = replay;
+    work.context = context;
+    work.next = 0;
+
+    for (size_t j {}; j < count; j++) {
+        jobs[j].metrics = ReplayMetrics {};
+    }
+
+#if defined(CST_PARALLEL)
+    const std::chrono::steady_clock::time_point start {
+        std::chrono::steady_clock::now()
+    };
+    pool.run(pool.size(), replayWorker, &work, 1);
+    report.seconds = std::chrono::duration<float>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+#else
+    pool.run(pool.size(), replayWorker, &work, 1);
+#endif
+
+    // merged in job order, so the result does not depend on the timing
+    for (size_t l {}; l < logs; l++) {
+        perLog[l] = ReplayMetrics {};
+    }
+    for (size_t j {}; j < count; j++) {
+        perLog[jobs[j].log].merge(jobs[j].metrics);
+        report.samples += cost(jobs[j]);
+    }
+
+    return report;
+}
@@ -0,0 +1,255 @@
+/**
+ * @file replay.h
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Parallel replay of recorded logs with per-log metrics.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef __LIB_CUSTOM_TYPE_REPLAY_H__
+#define __LIB_CUSTOM_TYPE_REPLAY_H__
+
+#include <cmath>
+#include <stddef.h>
+#include "def.h"
+#include "parallel.h"
+
+/**
+ * @brief Error statistics of a replay.
+ */
+struct ReplayMetrics {
+    /**
+     * @brief Number of scored samples.
+     */
+    size_t samples;
+    /**
+     * @brief Sum of the squared errors, in double: a float sum stops
+     * growing once a log is a few million samples long.
+     */
+    double sumSquares;
+    /**
+     * @brief Largest error.
+     */
+    float maxError;
+
+    /**
+     * @brief Score one sample.
+     *
+     * @param error Error of the sample, e.g. an attitude error angle.
+     */
+    void add(float error) {
+        samples++;
+        sumSquares += static_cast<double>(error) * error;
+        maxError = error > maxError ? error : maxError;
+    }
+
+    /**
+     * @brief Add the samples of another replay.
+     *
+     * @param m Metrics.
+     */
+    void merge(const ReplayMetrics& m) {
+        samples += m.samples;
+        sumSquares += m.sumSquares;
+        maxError = m.maxError > maxError ? m.maxError : maxError;
+    }
+
+    /**
+     * @brief Root mean square error.
+     *
+     * @return 0 without samples.
+     */
+    float rms() const {
+        return samples > 0
+            ? static_cast<float>(
+                sqrt(sumSquares / static_cast<double>(samples)))
+            : 0.0f;
+    }
+};
+
+/**
+ * @brief Part of a log to replay.
+ */
+struct ReplayJob {
+    /**
+     * @brief Log index.
+     */
+    size_t log;
+    /**
+     * @brief First sample replayed, @c begin minus the warm-up (clamped).
+     */
+    size_t start;
+    /**
+     * @brief First scored sample.
+     */
+    size_t begin;
+    /**
+     * @brief Sample past the last one.
+     */
+    size_t end;
+    /**
+     * @brief Metrics of [@c begin, @c end).
+     */
+    ReplayMetrics metrics;
+};
+
+/**
+ * @brief Replay body: run the filter over [@c start, @c end) of the log
+ * from a fresh state and score [@c begin, @c end) into @c job.metrics.
+ */
+typedef void (*ReplayFunction)(void* context, ReplayJob& job);
+
+/**
+ * @brief Summary of a #ReplayScheduler::run.
+ */
+struct ReplayReport {
+    /**
+     * @brief Number of logs.
+     */
+    size_t logs;
+    /**
+     * @brief Number of jobs (segments).
+     */
+    size_t jobs;
+    /**
+     * @brief Samples replayed, warm-ups included.
+     */
+    size_t samples;
+    /**
+     * @brief Number of workers.
+     */
+    size_t workers;
+    /**
+     * @brief Wall time (seconds), 0 without CST_PARALLEL.
+     */
+    float seconds;
+
+    /**
+     * @brief Throughput (samples per second per worker).
+     *
+     * @return 0 if no time was measured.
+     */
+    float perCore() const {
+        return seconds > 0.0f
+            ? static_cast<float>(samples)
+                / (seconds * static_cast<float>(workers))
+            : 0.0f;
+    }
+};
+
+/**
+ * @class ReplayScheduler
+ * @brief Replays independent logs of very different lengths on a
+ * ParallelPool.
+ *
+ * Jobs are sorted longest first and claimed one at a time from a shared
+ * counter: the longest logs start first and short ones fill the gaps at
+ * the end (greedy LPT schedule). Logs flagged as splittable, i.e. whose
+ * filter converges from a fresh state, are cut into segments; each segment
+ * replays a warm-up before its first scored sample, so segments are
+ * independent too. The job list lives in a caller buffer.
+ */
+class ReplayScheduler {
+  private:
+    /**
+     * @brief Job buffer.
+     */
+    ReplayJob* jobs;
+    /**
+     * @brief Capacity of #jobs.
+     */
+    size_t capacity;
+    /**
+     * @brief Number of planned jobs.
+     */
+    size_t count;
+    /**
+     * @brief Number of planned logs.
+     */
+    size_t logs;
+    /**
+     * @brief Segment length (samples), 0 never splits.
+     */
+    size_t segment;
+    /**
+     * @brief Warm-up length (samples).
+     */
+    size_t warmup;
+
+    /**
+     * @brief Adapter calling a functor with a job.
+     */
+    template <class F>
+    static void invoke(void* f, ReplayJob& job) {
+        (*static_cast<const F*>(f))(job);
+    }
+
+  public:
+    /**
+     * @brief Construct a new ReplayScheduler object.
+     *
+     * @param buffer Job buffer.
+     * @param size Capacity of @p buffer.
+     */
+    ReplayScheduler(ReplayJob* buffer, size_t size);
+
+    /**
+     * @brief Set the splitting of long logs.
+     *
+     * @param length Segment length (samples), 0 never splits.
+     * @param overlap Warm-up replayed before each later segment (samples).
+     */
+    void setSplit(size_t length, size_t overlap);
+
+    /**
+     * @brief Build the job list, longest first.
+     *
+     * @param lengths Number of samples of each log.
+     * @param splittable Whether each log may be split, nullptr for none.
+     * @param n Number of logs.
+     * @return Number of jobs, 0 if the buffer is too small.
+     */
+    size_t plan(const size_t* lengths, const bool* splittable, size_t n);
+
+    /**
+     * @brief Planned jobs.
+     *
+     * @return const ReplayJob*
+     */
+    const ReplayJob* planned() const;
+
+    /**
+     * @brief Replay the planned jobs and merge their metrics per log.
+     *
+     * @param pool Workers.
+     * @param replay Replay body, called concurrently on different jobs.
+     * @param context Passed to @p replay.
+     * @param perLog Metrics of each log, as many as planned logs.
+     * @return ReplayReport
+     */
+    ReplayReport run(
+        ParallelPool& pool,
+        ReplayFunction replay,
+        void* context,
+        ReplayMetrics* perLog);
+
+    /**
+     * @brief Replay the planned jobs with a functor @c f(job).
+     *
+     * @param pool Workers.
+     * @param f Functor, called concurrently on different jobs.
+     * @param perLog Metrics of each log, as many as planned logs.
+     * @return ReplayReport
+     */
+    template <class F>
+    ReplayReport run(ParallelPool& pool, const F& f, ReplayMetrics* perLog) {
+        return run(
+            pool, &ReplayScheduler::invoke<F>, const_cast<F*>(&f), perLog);
+    }
+};
+
+#endif /* __LIB_CUSTOM_TYPE_REPLAY_H__ */
@@ -0,0 +1,357 @@
+/**
+ * @file resample.cpp
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Resampling of timestamped Vector and Quaternion streams.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "resample.h"
+
+namespace {
+/**
+ * @brief Interval of @p t, the last @p i with @f$t_i\leq t@f$, clamped
+ * to [0, n - 2].
+ *
+ * @param times Increasing timestamps.
+ * @param n Number of timestamps, at least 2.
+ * @param t Time.
+ * @return Interval index.
+ */
+size_t locate(const double* times, size_t n, double t) {
+    size_t lo {};
+    size_t hi { n - 1 };
+
+    while (hi - lo > 1) {
+        const size_t mid { lo + (hi - lo) / 2 };
+        if (times[mid] <= t) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+
+    return lo;
+}
+
+/**
+ * @brief Signed time from @p from to @p to, wrap-safe.
+ *
+ * @param from Timestamp (microseconds).
+ * @param to Timestamp (microseconds).
+ * @return Seconds, negative if @p to is earlier.
+ */
+inline double elapsed(uint32_t from, uint32_t to) {
+    return static_cast<double>(static_cast<int32_t>(to - from)) * 1e-6;
+}
+
+/**
+ * @brief Window times in seconds from the oldest sample.
+ *
+ * @param stamps Timestamps (microseconds).
+ * @param n Number of timestamps.
+ * @param out Times (seconds).
+ */
+void window(const uint32_t* stamps, size_t n, double* out) {
+    for (size_t k {}; k < n; k++) {
+        out[k] = elapsed(stamps[0], stamps[k]);
+    }
+}
+}  // namespace
+
+Vector Resampler::interpolate(
+    const double* times,
+    const VectorArray& samples,
+    size_t i,
+    double t,
+    bool cubic) {
+    const double h { times[i + 1] - times[i] };
+    const float u { h > 0.0 ? static_cast<float>((t - times[i]) / h) : 0.0f };
+    const Vector p1 { samples.get(i) };
+    const Vector p2 { samples.get(i + 1) };
+
+    if (!cubic) {
+        return p1 + (p2 - p1) * u;
+    }
+
+    // tangents from the neighbours, one-sided at the ends, scaled to the
+    // interval length
+    const size_t i0 { i > 0 ? i - 1 : i };
+    const size_t i3 { i + 2 < samples.length ? i + 2 : i + 1 };
+    const Vector m1 {
+        (p2 - samples.get(i0))
+        * static_cast<float>(h / (times[i + 1] - times[i0]))
+    };
+    const Vector m2 {
+        (samples.get(i3) - p1) * static_cast<float>(h / (times[i3] - times[i]))
+    };
+    const float u2 { u * u };
+    const float u3 { u2 * u };
+
+    return p1 * (2.0f * u3 - 3.0f * u2 + 1.0f) + m1 * (u3 - 2.0f * u2 + u)
+        + p2 * (3.0f * u2 - 2.0f * u3) + m2 * (u3 - u2);
+}
+
+Quaternion Resampler::interpolate(
+    const double* times,
+    const QuaternionArray& samples,
+    size_t i,
+    double t,
+    QuaternionInterpolation method) {
+    const double h { times[i + 1] - times[i] };
+    const float u { h > 0.0 ? static_cast<float>((t - times[i]) / h) : 0.0f };
+    const Quaternion q1 { samples.get(i) };
+    const Quaternion q2 { samples.get(i + 1) };
+
+    if (method == QUATERNION_NLERP) {
+        return Quaternion::nlerp(q1, q2, u);
+    }
+    if (method == QUATERNION_SLERP) {
+        return Quaternion::slerp(q1, q2, u);
+    }
+
+    const size_t i0 { i > 0 ? i - 1 : i };
+    const size_t i3 { i + 2 < samples.length ? i + 2 : i + 1 };
+    const Quaternion s1 {
+        Quaternion::squadControl(samples.get(i0), q1, q2)
+    };
+    const Quaternion s2 {
+        Quaternion::squadControl(q1, q2, samples.get(i3))
+    };
+
+    return Quaternion::squad(q1, q2, s1, s2, u);
+}
+
+void Resampler::resample(
+    const double* times,
+    const VectorArray& samples,
+    const double* at,
+    VectorArray& out,
+    bool cubic) {
+    const size_t n { samples.length };
+    if (n == 0 || out.length == 0) {
+        return;
+    }
+
+    size_t i { n > 1 ? locate(times, n, at[0]) : 0 };
+
+    for (size_t k {}; k < out.length; k++) {
+        const double t { at[k] };
+        if (n == 1 || t <= times[0]) {
+            out.set(k, samples.get(0));
+            continue;
+        }
+        if (t >= times[n - 1]) {
+            out.set(k, samples.get(n - 1));
+            continue;
+        }
+        while (times[i + 1] < t) {
+            i++;
+        }
+        out.set(k, interpolate(times, samples, i, t, cubic));
+    }
+}
+
+void Resampler::resample(
+    const double* times,
+    const QuaternionArray& samples,
+    const double* at,
+    QuaternionArray& out,
+    QuaternionInterpolation method) {
+    const size_t n { samples.length };
+    if (n == 0 || out.length == 0) {
+        return;
+    }
+
+    size_t i { n > 1 ? locate(times, n, at[0]) : 0 };
+    // squad control points of interval #i, computed once per interval
+    size_t controls { n };
+    Quaternion s1 {};
+    Quaternion s2 {};
+
+    for (size_t k {}; k < out.length; k++) {
+        const double t { at[k] };
+        if (n == 1 || t <= times[0]) {
+            out.set(k, samples.get(0));
+            continue;
+        }
+        if (t >= times[n - 1]) {
+            out.set(k, samples.get(n - 1));
+            continue;
+        }
+        while (times[i + 1] < t) {
+            i++;
+        }
+        if (method != QUATERNION_SQUAD) {
+            out.set(k, interpolate(times, samples, i, t, method));
+            continue;
+        }
+
+        const Quaternion q1 { samples.get(i) };
+        const Quaternion q2 { samples.get(i + 1) };
+        if (controls != i) {
+            const size_t i0 { i > 0 ? i - 1 : i };
+            const size_t i3 { i + 2 < n ? i + 2 : i + 1 };
+            s1 = Quaternion::squadControl(samples.get(i0), q1, q2);
+            s2 = Quaternion::squadControl(q1, q2, samples.get(i3));
+            controls = i;
+        }
+        const double h { times[i + 1] - times[i] };
+        const float u {
+            h > 0.0 ? static_cast<float>((t - times[i]) / h) : 0.0f
+        };
+        out.set(k, Quaternion::squad(q1, q2, s1, s2, u));
+    }
+}
+
+void Resampler::resample(
+    ParallelPool& pool,
+    const double* times,
+    const VectorArray& samples,
+    const double* at,
+    VectorArray& out,
+    bool cubic) {
+    pool.forEach(out, [&](const VectorArray& chunk, size_t offset) {
+        VectorArray o { chunk };
+        resample(times, samples, at + offset, o, cubic);
+    });
+}
+
+void Resampler::resample(
+    ParallelPool& pool,
+    const double* times,
+    const QuaternionArray& samples,
+    const double* at,
+    QuaternionArray& out,
+    QuaternionInterpolation method) {
+    pool.forEach(out, [&](const QuaternionArray& chunk, size_t offset) {
+        QuaternionArray o { chunk };
+        resample(times, samples, at + offset, o, method);
+    });
+}
+
+StreamResampler::StreamResampler(uint32_t outPeriod, bool useCubic) :
+    count { 0 },
+    period { outPeriod },
+    origin { 0 },
+    emitted { 0 },
+    cubic { useCubic } {}
+
+void StreamResampler::reset(uint32_t start) {
+    count = 0;
+    origin = start;
+    emitted = 0;
+}
+
+void StreamResampler::push(uint32_t t, const Vector& v) {
+    if (count == RESAMPLE_WINDOW) {
+        for (size_t k { 1 }; k < RESAMPLE_WINDOW; k++) {
+            times[k - 1] = times[k];
+            values[0][k - 1] = values[0][k];
+            values[1][k - 1] = values[1][k];
+            values[2][k - 1] = values[2][k];
+        }
+        count--;
+    }
+
+    times[count] = t;
+    values[0][count] = v.x;
+    values[1][count] = v.y;
+    values[2][count] = v.z;
+    count++;
+}
+
+bool StreamResampler::pop(uint32_t& t, Vector& v) {
+    const uint32_t at { origin + emitted * period };
+    const VectorArray samples { values[0], values[1], values[2], count };
+
+    if (count == 0 || elapsed(times[count - 1], at) > 0.0) {
+        return false;
+    }
+
+    const double offset { elapsed(times[0], at) };
+    if (offset <= 0.0) {
+        v = samples.get(0);
+    } else {
+        double seconds[RESAMPLE_WINDOW];
+        window(times, count, seconds);
+        const size_t i { locate(seconds, count, offset) };
+        if (cubic && i + 2 >= count) {
+            return false;
+        }
+        v = Resampler::interpolate(seconds, samples, i, offset, cubic);
+    }
+
+    t = at;
+    emitted++;
+
+    return true;
+}
+
+QuaternionStreamResampler::QuaternionStreamResampler(
+    uint32_t outPeriod,
+    QuaternionInterpolation m) :
+    count { 0 },
+    period { outPeriod },
+    origin { 0 },
+    emitted { 0 },
+    method { m } {}
+
+void QuaternionStreamResampler::reset(uint32_t start) {
+    count = 0;
+    origin = start;
+    emitted = 0;
+}
+
+void QuaternionStreamResampler::push(uint32_t t, const Quaternion& q) {
+    if (count == RESAMPLE_WINDOW) {
+        for (size_t k { 1 }; k < RESAMPLE_WINDOW; k++) {
+            times[k - 1] = times[k];
+            values[0][k - 1] = values[0][k];
+            values[1][k - 1] = values[1][k];
+            values[2][k - 1] = values[2][k];
+            values[3][k - 1] = values[3][k];
+        }
+        count--;
+    }
+
+    times[count] = t;
+    values[0][count] = q.w;
+    values[1][count] = q.x;
+    values[2][count] = q.y;
+    values[3][count] = q.z;
+    count++;
+}
+
+bool QuaternionStreamResampler::pop(uint32_t& t, Quaternion& q) {
+    const uint32_t at { origin + emitted * period };
+    const QuaternionArray samples {
+        values[0], values[1], values[2], values[3], count,
+    };
+
+    if (count == 0 || elapsed(times[count - 1], at) > 0.0) {
+        return false;
+    }
+
+    const double offset { elapsed(times[0], at) };
+    if (offset <= 0.0) {
+        q = samples.get(0);
+    } else {
+        double seconds[RESAMPLE_WINDOW];
+        window(times, count, seconds);
+        const size_t i { locate(seconds, count, offset) };
+        if (method == QUATERNION_SQUAD && i + 2 >= count) {
+            return false;
+        }
+        q = Resampler::interpolate(seconds, samples, i, offset, method);
+    }
+
+    t = at;
+    emitted++;
+
+    return true;
+}
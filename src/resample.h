@@ -0,0 +1,318 @@
+/**
+ * @file resample.h
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Resampling of timestamped Vector and Quaternion streams.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef __LIB_CUSTOM_TYPE_RESAMPLE_H__
+#define __LIB_CUSTOM_TYPE_RESAMPLE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "def.h"
+#include "vector.h"
+#include "quaternion.h"
+#include "arrays.h"
+#include "parallel.h"
+
+/**
+ * @brief Quaternion interpolation methods.
+ */
+enum QuaternionInterpolation {
+    QUATERNION_NLERP,
+    QUATERNION_SLERP,
+    QUATERNION_SQUAD,
+};
+
+/**
+ * @brief Samples kept by the online resamplers.
+ */
+const size_t RESAMPLE_WINDOW { 4 };
+
+/**
+ * @class Resampler
+ * @brief Offline resampling of timestamped streams onto output times.
+ *
+ * Input and output times must be increasing. Both are walked once with a
+ * cursor (one binary search locates the first output), so a call costs
+ * O(inputs + outputs). Outputs are independent: the ParallelPool overloads
+ * split a long output clock into chunks, each with its own binary search.
+ * Output times outside the input span hold the first/last sample.
+ *
+ * Cubic interpolation is a Hermite spline with finite-difference tangents
+ * that account for uneven timestamps.
+ *
+ * Times are seconds in double, so a log of days still resolves
+ * microseconds: intervals are formed in double and only the interpolation
+ * weights are float.
+ */
+class Resampler {
+  public:
+    /**
+     * @brief Resample vectors.
+     *
+     * @param times Input times (seconds), @p samples.length of them.
+     * @param samples Input vectors.
+     * @param at Output times (seconds), @p out.length of them.
+     * @param out Resampled vectors.
+     * @param cubic Cubic Hermite instead of linear interpolation.
+     */
+    static void resample(
+        const double* times,
+        const VectorArray& samples,
+        const double* at,
+        VectorArray& out,
+        bool cubic = false);
+
+    /**
+     * @brief Resample rotations.
+     *
+     * @param times Input times (seconds), @p samples.length of them.
+     * @param samples Input unit quaternions.
+     * @param at Output times (seconds), @p out.length of them.
+     * @param out Resampled quaternions.
+     * @param method Interpolation method.
+     */
+    static void resample(
+        const double* times,
+        const QuaternionArray& samples,
+        const double* at,
+        QuaternionArray& out,
+        QuaternionInterpolation method = QUATERNION_SLERP);
+
+    /**
+     * @brief Resample vectors on a ParallelPool. The output clock is split
+     * into chunks, each resampled as by the serial overload from its own
+     * binary search; the result matches the serial overload.
+     *
+     * @param pool Workers.
+     * @param times Input times (seconds), @p samples.length of them.
+     * @param samples Input vectors.
+     * @param at Output times (seconds), @p out.length of them.
+     * @param out Resampled vectors.
+     * @param cubic Cubic Hermite instead of linear interpolation.
+     */
+    static void resample(
+        ParallelPool& pool,
+        const double* times,
+        const VectorArray& samples,
+        const double* at,
+        VectorArray& out,
+        bool cubic = false);
+
+    /**
+     * @brief Resample rotations on a ParallelPool, see the vector overload.
+     *
+     * @param pool Workers.
+     * @param times Input times (seconds), @p samples.length of them.
+     * @param samples Input unit quaternions.
+     * @param at Output times (seconds), @p out.length of them.
+     * @param out Resampled quaternions.
+     * @param method Interpolation method.
+     */
+    static void resample(
+        ParallelPool& pool,
+        const double* times,
+        const QuaternionArray& samples,
+        const double* at,
+        QuaternionArray& out,
+        QuaternionInterpolation method = QUATERNION_SLERP);
+
+    /**
+     * @brief Vector at @p t between samples @p i and @p i + 1.
+     *
+     * @param times Times (seconds).
+     * @param samples Vectors.
+     * @param i Interval, @f$t_i\leq t\leq t_{i+1}@f$.
+     * @param t Time (seconds).
+     * @param cubic Cubic Hermite instead of linear interpolation.
+     * @return Vector
+     */
+    static Vector interpolate(
+        const double* times,
+        const VectorArray& samples,
+        size_t i,
+        double t,
+        bool cubic);
+
+    /**
+     * @brief Rotation at @p t between samples @p i and @p i + 1.
+     *
+     * @param times Times (seconds).
+     * @param samples Unit quaternions.
+     * @param i Interval, @f$t_i\leq t\leq t_{i+1}@f$.
+     * @param t Time (seconds).
+     * @param method Interpolation method.
+     * @return Quaternion
+     */
+    static Quaternion interpolate(
+        const double* times,
+        const QuaternionArray& samples,
+        size_t i,
+        double t,
+        QuaternionInterpolation method);
+};
+
+/**
+ * @class StreamResampler
+ * @brief Online resampling of a timestamped Vector stream onto a fixed
+ * output period.
+ *
+ * The last #RESAMPLE_WINDOW samples are kept. An output is released as
+ * soon as the sample after it arrives (linear) or the one after that
+ * (cubic), so the latency is bounded by one or two input periods. Drain
+ * #pop after each #push.
+ *
+ * Timestamps are microseconds, e.g. @c micros() or Packet::timestamp. Only
+ * differences are used, so the counter may wrap around and a stream can
+ * run indefinitely, as long as consecutive samples are less than 35
+ * minutes apart.
+ */
+class StreamResampler {
+  private:
+    /**
+     * @brief Window timestamps (microseconds), oldest first.
+     */
+    uint32_t times[RESAMPLE_WINDOW];
+    /**
+     * @brief Window storage (x, y, z).
+     */
+    float values[3][RESAMPLE_WINDOW];
+    /**
+     * @brief Number of samples in the window.
+     */
+    size_t count;
+    /**
+     * @brief Output period (microseconds).
+     */
+    uint32_t period;
+    /**
+     * @brief Time of the first output.
+     */
+    uint32_t origin;
+    /**
+     * @brief Number of outputs released, the next one is at
+     * #origin + #emitted * #period (exact, wraps with the timestamps).
+     */
+    uint32_t emitted;
+    /**
+     * @brief Cubic Hermite instead of linear interpolation.
+     */
+    bool cubic;
+
+  public:
+    /**
+     * @brief Construct a new StreamResampler object.
+     *
+     * @param outPeriod Output period (microseconds).
+     * @param useCubic Cubic Hermite instead of linear interpolation.
+     */
+    explicit StreamResampler(
+        uint32_t outPeriod = 10000,
+        bool useCubic = false);
+
+    /**
+     * @brief Empty the window and set the first output time.
+     *
+     * @param start Time of the first output (microseconds).
+     */
+    void reset(uint32_t start);
+
+    /**
+     * @brief Add an input sample.
+     *
+     * @param t Timestamp (microseconds), later than the previous one.
+     * @param v Sample.
+     */
+    void push(uint32_t t, const Vector& v);
+
+    /**
+     * @brief Take the next output if it can be computed.
+     *
+     * @param t Output time (microseconds).
+     * @param v Output sample.
+     * @return false if more input is needed.
+     */
+    bool pop(uint32_t& t, Vector& v);
+};
+
+/**
+ * @class QuaternionStreamResampler
+ * @brief Online resampling of a timestamped rotation stream, see
+ * #StreamResampler. Squad waits for one more sample than nlerp and slerp.
+ */
+class QuaternionStreamResampler {
+  private:
+    /**
+     * @brief Window timestamps (microseconds), oldest first.
+     */
+    uint32_t times[RESAMPLE_WINDOW];
+    /**
+     * @brief Window storage (w, x, y, z).
+     */
+    float values[4][RESAMPLE_WINDOW];
+    /**
+     * @brief Number of samples in the window.
+     */
+    size_t count;
+    /**
+     * @brief Output period (microseconds).
+     */
+    uint32_t period;
+    /**
+     * @brief Time of the first output.
+     */
+    uint32_t origin;
+    /**
+     * @brief Number of outputs released, the next one is at
+     * #origin + #emitted * #period (exact, wraps with the timestamps).
+     */
+    uint32_t emitted;
+    /**
+     * @brief Interpolation method.
+     */
+    QuaternionInterpolation method;
+
+  public:
+    /**
+     * @brief Construct a new QuaternionStreamResampler object.
+     *
+     * @param outPeriod Output period (microseconds).
+     * @param m Interpolation method.
+     */
+    explicit QuaternionStreamResampler(
+        uint32_t outPeriod = 10000,
+        QuaternionInterpolation m = QUATERNION_SLERP);
+
+    /**
+     * @brief Empty the window and set the first output time.
+     *
+     * @param start Time of the first output (microseconds).
+     */
+    void reset(uint32_t start);
+
+    /**
+     * @brief Add an input sample.
+     *
+     * @param t Timestamp (microseconds), later than the previous one.
+     * @param q Unit quaternion.
+     */
+    void push(uint32_t t, const Quaternion& q);
+
+    /**
+     * @brief Take the next output if it can be computed.
+     *
+     * @param t Output time (microseconds).
+     * @param q Output rotation.
+     * @return false if more input is needed.
+     */
+    bool pop(uint32_t& t, Quaternion& q);
+};
+
+#endif /* __LIB_CUSTOM_TYPE_RESAMPLE_H__ */
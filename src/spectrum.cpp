@@ -0,0 +1,320 @@
+/**
+ * @file spectrum.cpp
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Real FFT and spectral metrics for 3-axis streams.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "spectrum.h"
+
+#include <string.h>
+
+RealFFT::RealFFT() : n { 0 } {}
+
+bool RealFFT::plan(size_t size) {
+    if (size < 4 || size > FFT_MAX_SIZE || (size & (size - 1)) != 0) {
+        return false;
+    }
+
+    n = size;
+    const size_t m { n / 2 };
+
+    size_t bits {};
+    while ((static_cast<size_t>(1) << bits) < m) {
+        bits++;
+    }
+    for (size_t k {}; k < m; k++) {
+        size_t r {};
+        for (size_t b {}; b < bits; b++) {
+            r |= ((k >> b) & 1) << (bits - 1 - b);
+        }
+        reversed[k] = static_cast<uint16_t>(r);
+    }
+
+    for (size_t h { 1 }; h < m; h *= 2) {
+        for (size_t j {}; j < h; j++) {
+            const float a {
+                cst::PI * static_cast<float>(j) / static_cast<float>(h)
+            };
+            stageRe[h - 1 + j] = cosf(a);
+            stageIm[h - 1 + j] = -sinf(a);
+        }
+    }
+
+    for (size_t k {}; k < m; k++) {
+        const float a {
+            2.0f * cst::PI * static_cast<float>(k) / static_cast<float>(n)
+        };
+        splitRe[k] = cosf(a);
+        splitIm[k] = -sinf(a);
+    }
+
+    return true;
+}
+
+size_t RealFFT::size() const {
+    return n;
+}
+
+void RealFFT::forward(const float* in, float* re, float* im) const {
+    const size_t m { n / 2 };
+
+    // z_k = x_2k + i x_2k+1, in bit-reversed order
+    for (size_t k {}; k < m; k++) {
+        re[reversed[k]] = in[2 * k];
+        im[reversed[k]] = in[2 * k + 1];
+    }
+
+    for (size_t h { 1 }; h < m; h *= 2) {
+        const float* CST_RESTRICT wr { stageRe + h - 1 };
+        const float* CST_RESTRICT wi { stageIm + h - 1 };
+        for (size_t s {}; s < m; s += 2 * h) {
+            float* CST_RESTRICT ar { re + s };
+            float* CST_RESTRICT ai { im + s };
+            float* CST_RESTRICT br { re + s + h };
+            float* CST_RESTRICT bi { im + s + h };
+            CST_IVDEP
+            for (size_t j {}; j < h; j++) {
+                const float tr { wr[j] * br[j] - wi[j] * bi[j] };
+                const float ti { wr[j] * bi[j] + wi[j] * br[j] };
+                br[j] = ar[j] - tr;
+                bi[j] = ai[j] - ti;
+                ar[j] += tr;
+                ai[j] += ti;
+            }
+        }
+    }
+
+    // split: X_k = E_k + W^k O_k, X_m-k = conj(E_k - W^k O_k) with
+    // E_k = (z_k + conj(z_m-k)) / 2 and O_k = -i (z_k - conj(z_m-k)) / 2
+    const float r0 { re[0] };
+    const float i0 { im[0] };
+    re[0] = r0 + i0;
+    im[0] = 0.0f;
+    re[m] = r0 - i0;
+    im[m] = 0.0f;
+
+    for (size_t k { 1 }; k <= m / 2; k++) {
+        const float ar { re[k] };
+        const float ai { im[k] };
+        const float br { re[m - k] };
+        const float bi { -im[m - k] };
+        const float er { 0.5f * (ar + br) };
+        const float ei { 0.5f * (ai + bi) };
+        const float orr { 0.5f * (ai - bi) };
+        const float oi { -0.5f * (ar - br) };
+        const float tr { splitRe[k] * orr - splitIm[k] * oi };
+        const float ti { splitRe[k] * oi + splitIm[k] * orr };
+
+        re[k] = er + tr;
+        im[k] = ei + ti;
+        re[m - k] = er - tr;
+        im[m - k] = -(ei - ti);
+    }
+}
+
+WelchPSD::WelchPSD() :
+    norm { 0.0f },
+    rate { 1.0f },
+    segments { 0 },
+    held { 0 } {
+    reset();
+}
+
+bool WelchPSD::configure(size_t size, float sampleRate) {
+    if (!fft.plan(size)) {
+        return false;
+    }
+
+    rate = sampleRate;
+    float energy {};
+    for (size_t i {}; i < size; i++) {
+        window[i] = 0.5f
+            - 0.5f
+                * cosf(
+                    2.0f * cst::PI * static_cast<float>(i)
+                    / static_cast<float>(size));
+        energy += cst::sqr(window[i]);
+    }
+    norm = 1.0f / (rate * energy);
+
+    reset();
+
+    return true;
+}
+
+void WelchPSD::reset() {
+    for (size_t a {}; a < 3; a++) {
+        for (size_t k {}; k < FFT_MAX_BINS; k++) {
+            power[a][k] = 0.0f;
+        }
+    }
+    segments = 0;
+    held = 0;
+}
+
+void WelchPSD::accumulate(const float* const axes[3]) {
+    const size_t size { fft.size() };
+    const size_t nb { bins() };
+    float seg[FFT_MAX_SIZE];
+    float re[FFT_MAX_BINS];
+    float im[FFT_MAX_BINS];
+
+    for (size_t a {}; a < 3; a++) {
+        const float* CST_RESTRICT src { axes[a] };
+        float mean {};
+        for (size_t i {}; i < size; i++) {
+            mean += src[i];
+        }
+        mean /= static_cast<float>(size);
+
+        CST_IVDEP
+        for (size_t i {}; i < size; i++) {
+            seg[i] = (src[i] - mean) * window[i];
+        }
+
+        fft.forward(seg, re, im);
+
+        float* CST_RESTRICT p { power[a] };
+        CST_IVDEP
+        for (size_t k {}; k < nb; k++) {
+            p[k] += re[k] * re[k] + im[k] * im[k];
+        }
+    }
+}
+
+size_t WelchPSD::add(const VectorArray& signal) {
+    const size_t size { fft.size() };
+    if (size == 0) {
+        return 0;
+    }
+
+    const size_t hop { size / 2 };
+    const float* const kept[3] { tail[0], tail[1], tail[2] };
+    size_t added {};
+    size_t i {};
+
+    while (i < signal.length) {
+        const size_t left { signal.length - i };
+
+        if (held == 0 && left >= size) {
+            // whole segment in the chunk, no copy
+            const float* const axes[3] {
+                signal.x + i,
+                signal.y + i,
+                signal.z + i,
+            };
+            accumulate(axes);
+            added++;
+            i += hop;
+            continue;
+        }
+
+        // complete the kept segment, or keep the end of the chunk
+        const size_t n { size - held < left ? size - held : left };
+        memcpy(tail[0] + held, signal.x + i, n * sizeof(float));
+        memcpy(tail[1] + held, signal.y + i, n * sizeof(float));
+        memcpy(tail[2] + held, signal.z + i, n * sizeof(float));
+        held += n;
+        i += n;
+
+        if (held == size) {
+            accumulate(kept);
+            added++;
+            if (n >= size - hop) {
+                // the next segment starts in the chunk: back to no copy
+                held = 0;
+                i -= size - hop;
+            } else {
+                // the second half starts the next segment
+                for (size_t a {}; a < 3; a++) {
+                    memmove(
+                        tail[a], tail[a] + hop, (size - hop) * sizeof(float));
+                }
+                held = size - hop;
+            }
+        }
+    }
+
+    segments += added;
+
+    return added;
+}
+
+size_t WelchPSD::count() const {
+    return segments;
+}
+
+size_t WelchPSD::bins() const {
+    return fft.size() / 2 + 1;
+}
+
+float WelchPSD::frequency(size_t k) const {
+    return rate * static_cast<float>(k) / static_cast<float>(fft.size());
+}
+
+Vector WelchPSD::density(size_t k) const {
+    if (segments == 0) {
+        return Vector {};
+    }
+
+    // one-sided: the bins between DC and Nyquist fold their negative twin
+    const float twice { k == 0 || k == bins() - 1 ? 1.0f : 2.0f };
+    const float f { twice * norm / static_cast<float>(segments) };
+
+    return Vector { power[0][k] * f, power[1][k] * f, power[2][k] * f };
+}
+
+Vector WelchPSD::bandRms(float low, float high) const {
+    const float df { rate / static_cast<float>(fft.size()) };
+    Vector sum;
+
+    for (size_t k {}; k < bins(); k++) {
+        const float f { frequency(k) };
+        if (f >= low && f <= high) {
+            sum += density(k);
+        }
+    }
+    sum *= df;
+
+    return Vector { sqrtf(sum.x), sqrtf(sum.y), sqrtf(sum.z) };
+}
+
+size_t WelchPSD::peaks(
+    size_t axis,
+    size_t found[],
+    size_t max,
+    float threshold) const {
+    if (segments == 0 || axis > 2 || max == 0) {
+        return 0;
+    }
+
+    const float* p { power[axis] };
+    const float scale { 2.0f * norm / static_cast<float>(segments) };
+    size_t n {};
+
+    for (size_t k { 1 }; k + 1 < bins(); k++) {
+        if (p[k] <= p[k - 1] || p[k] < p[k + 1] || p[k] * scale < threshold) {
+            continue;
+        }
+
+        // insertion into the sorted list, the weakest falls off
+        size_t i { n < max ? n++ : max };
+        while (i > 0 && p[found[i - 1]] < p[k]) {
+            if (i < max) {
+                found[i] = found[i - 1];
+            }
+            i--;
+        }
+        if (i < max) {
+            found[i] = k;
+        }
+    }
+
+    return n;
+}
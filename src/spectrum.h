@@ -0,0 +1,236 @@
+/**
+ * @file spectrum.h
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Real FFT and spectral metrics for 3-axis streams.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef __LIB_CUSTOM_TYPE_SPECTRUM_H__
+#define __LIB_CUSTOM_TYPE_SPECTRUM_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "def.h"
+#include "vector.h"
+#include "arrays.h"
+
+/**
+ * @brief Largest transform size (real samples).
+ */
+const size_t FFT_MAX_SIZE { 1024 };
+
+/**
+ * @brief Largest number of frequency bins, FFT_MAX_SIZE / 2 + 1.
+ */
+const size_t FFT_MAX_BINS { FFT_MAX_SIZE / 2 + 1 };
+
+/**
+ * @class RealFFT
+ * @brief Forward FFT of real, power-of-two sized blocks.
+ *
+ * A size n real transform is computed as a size n/2 complex transform of
+ * the even/odd samples (iterative radix-2) followed by a split step. All
+ * tables (bit reversal, per-stage twiddles stored contiguously so that the
+ * butterflies run at unit stride, split twiddles) are built by #plan;
+ * #forward allocates nothing and keeps no state.
+ */
+class RealFFT {
+  private:
+    /**
+     * @brief Transform size (real samples).
+     */
+    size_t n;
+    /**
+     * @brief Bit-reversed index of each complex sample.
+     */
+    uint16_t reversed[FFT_MAX_SIZE / 2];
+    /**
+     * @brief Twiddles of the stage of half-size h at [h - 1, 2h - 1), real
+     * part.
+     */
+    float stageRe[FFT_MAX_SIZE / 2];
+    /**
+     * @brief Stage twiddles, imaginary part.
+     */
+    float stageIm[FFT_MAX_SIZE / 2];
+    /**
+     * @brief Split twiddles @f$e^{-2\pi ik/n}@f$, real part.
+     */
+    float splitRe[FFT_MAX_SIZE / 2];
+    /**
+     * @brief Split twiddles, imaginary part.
+     */
+    float splitIm[FFT_MAX_SIZE / 2];
+
+  public:
+    /**
+     * @brief Construct an unplanned RealFFT object.
+     */
+    RealFFT();
+
+    /**
+     * @brief Build the tables for a transform size.
+     *
+     * @param size Power of two in [4, #FFT_MAX_SIZE].
+     * @return false if @p size is not supported (the plan is unchanged).
+     */
+    bool plan(size_t size);
+
+    /**
+     * @brief Transform size.
+     *
+     * @return 0 until planned.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Forward transform.
+     *
+     * @param in #size real samples.
+     * @param re Real parts of the #size / 2 + 1 bins.
+     * @param im Imaginary parts of the bins.
+     */
+    void forward(const float* in, float* re, float* im) const;
+};
+
+/**
+ * @class WelchPSD
+ * @brief One-sided power spectral density of the three axes of a Vector
+ * stream, Welch's method: Hann window, 50% overlap, mean removed from each
+ * segment (so gravity does not leak into the low bins).
+ */
+class WelchPSD {
+  private:
+    /**
+     * @brief Transform.
+     */
+    RealFFT fft;
+    /**
+     * @brief Hann window.
+     */
+    float window[FFT_MAX_SIZE];
+    /**
+     * @brief PSD normalisation, @f$1/(f_s\sum w^2)@f$.
+     */
+    float norm;
+    /**
+     * @brief Sample rate (Hz).
+     */
+    float rate;
+    /**
+     * @brief Accumulated periodograms, per axis.
+     */
+    float power[3][FFT_MAX_BINS];
+    /**
+     * @brief Number of accumulated segments.
+     */
+    size_t segments;
+    /**
+     * @brief Samples of the segment in progress, carried across #add
+     * calls.
+     */
+    float tail[3][FFT_MAX_SIZE];
+    /**
+     * @brief Number of samples in #tail, less than the segment length.
+     */
+    size_t held;
+
+    /**
+     * @brief Window, transform and accumulate one segment.
+     *
+     * @param axes Segment start of each axis.
+     */
+    void accumulate(const float* const axes[3]);
+
+  public:
+    /**
+     * @brief Construct an unconfigured WelchPSD object.
+     */
+    WelchPSD();
+
+    /**
+     * @brief Set the segment length and the sample rate, and reset.
+     *
+     * @param size Segment length, power of two in [4, #FFT_MAX_SIZE].
+     * @param sampleRate Sample rate (Hz).
+     * @return false if @p size is not supported.
+     */
+    bool configure(size_t size, float sampleRate);
+
+    /**
+     * @brief Forget the accumulated segments and the kept samples.
+     */
+    void reset();
+
+    /**
+     * @brief Accumulate the segments completed by a signal chunk (hop of
+     * half a segment). Successive calls are one continuous stream:
+     * samples that do not complete a segment are kept, so chunks of any
+     * length, e.g. DMA blocks shorter than a segment, add up.
+     *
+     * @param signal Samples.
+     * @return Number of segments added.
+     */
+    size_t add(const VectorArray& signal);
+
+    /**
+     * @brief Number of accumulated segments.
+     *
+     * @return size_t
+     */
+    size_t count() const;
+
+    /**
+     * @brief Number of frequency bins, segment length / 2 + 1.
+     *
+     * @return size_t
+     */
+    size_t bins() const;
+
+    /**
+     * @brief Centre frequency of a bin.
+     *
+     * @param k Bin index.
+     * @return Frequency (Hz).
+     */
+    float frequency(size_t k) const;
+
+    /**
+     * @brief Power spectral density of each axis.
+     *
+     * @param k Bin index.
+     * @return Vector (unit^2/Hz).
+     */
+    Vector density(size_t k) const;
+
+    /**
+     * @brief RMS of each axis in a frequency band, integral of the PSD.
+     *
+     * @param low Lower edge (Hz), included.
+     * @param high Upper edge (Hz), included.
+     * @return Vector
+     */
+    Vector bandRms(float low, float high) const;
+
+    /**
+     * @brief Strongest local maxima of an axis' PSD.
+     *
+     * @param axis 0, 1 or 2 for x, y or z.
+     * @param found Bin indices, by decreasing density.
+     * @param max Capacity of @p found.
+     * @param threshold Minimum density of a peak.
+     * @return Number of peaks found, at most @p max.
+     */
+    size_t peaks(
+        size_t axis,
+        size_t found[],
+        size_t max,
+        float threshold = 0.0f) const;
+};
+
+#endif /* __LIB_CUSTOM_TYPE_SPECTRUM_H__ */
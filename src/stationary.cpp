@@ -0,0 +1,204 @@
+/**
+ * @file stationary.cpp
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Stationary state detector and gyro bias estimator.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "stationary.h"
+#include "checkpoint.h"
+
+namespace {
+/**
+ * @brief Welford step of one component,
+ * @f$\sigma^2\leftarrow(1-\alpha)(\sigma^2+\alpha d^2)@f$.
+ *
+ * @param mu Mean, updated in place.
+ * @param var Variance, updated in place.
+ * @param x Sample.
+ * @param a Weight of the sample.
+ */
+inline void welford(float& mu, float& var, float x, float a) {
+    const float d { x - mu };
+    mu += a * d;
+    var = (1.0f - a) * (var + a * d * d);
+}
+}  // namespace
+
+StationaryDetector::StationaryDetector(
+    size_t n,
+    float gyroVariance,
+    float accelVariance) :
+    gyroMu {},
+    gyroVar {},
+    accelMu {},
+    accelVar {},
+    gyroBias {},
+    biasCount { 0 },
+    samples { 0 },
+    run { 0 },
+    still { false },
+    window { n > 0 ? n : 1 },
+    gyroThreshold { gyroVariance },
+    accelThreshold { accelVariance },
+    normLow { 0.0f },
+    normHigh { 0.0f },
+    enterCount { n },
+    exitCount { 5 } {
+    setAccelTolerance(0.05f, 9.80665f);
+}
+
+void StationaryDetector::setThresholds(
+    float gyroVariance,
+    float accelVariance) {
+    gyroThreshold = gyroVariance;
+    accelThreshold = accelVariance;
+}
+
+void StationaryDetector::setAccelTolerance(float tol, float g) {
+    normLow = cst::sqr(g * (1.0f - tol));
+    normHigh = cst::sqr(g * (1.0f + tol));
+}
+
+void StationaryDetector::setHysteresis(size_t enter, size_t exit) {
+    enterCount = enter;
+    exitCount = exit;
+}
+
+void StationaryDetector::reset() {
+    gyroMu = Vector {};
+    gyroVar = Vector {};
+    accelMu = Vector {};
+    accelVar = Vector {};
+    samples = 0;
+    run = 0;
+    still = false;
+}
+
+bool StationaryDetector::update(const Vector& gyro, const Vector& accel) {
+    // exact mean over the first window, exponential afterwards:
+    // var <- (1 - a) (var + a d^2) is Welford's update for a = 1/n
+    if (samples < window) {
+        samples++;
+    }
+    // scalar steps rather than Vector operators, so that #label inlines
+    const float a { 1.0f / static_cast<float>(samples) };
+    welford(gyroMu.x, gyroVar.x, gyro.x, a);
+    welford(gyroMu.y, gyroVar.y, gyro.y, a);
+    welford(gyroMu.z, gyroVar.z, gyro.z, a);
+    welford(accelMu.x, accelVar.x, accel.x, a);
+    welford(accelMu.y, accelVar.y, accel.y, a);
+    welford(accelMu.z, accelVar.z, accel.z, a);
+
+    const float n2 {
+        accel.x * accel.x + accel.y * accel.y + accel.z * accel.z
+    };
+    const bool candidate {
+        samples == window
+        && gyroVar.x + gyroVar.y + gyroVar.z < gyroThreshold
+        && accelVar.x + accelVar.y + accelVar.z < accelThreshold
+        && n2 > normLow && n2 < normHigh
+    };
+
+    if (candidate == still) {
+        run = 0;
+    } else if (++run >= (still ? exitCount : enterCount)) {
+        still = candidate;
+        run = 0;
+        if (still) {
+            gyroBias = gyroMu;
+            biasCount = window;
+        }
+    }
+
+    if (still && candidate) {
+        const float b { 1.0f / static_cast<float>(++biasCount) };
+        gyroBias.x += b * (gyro.x - gyroBias.x);
+        gyroBias.y += b * (gyro.y - gyroBias.y);
+        gyroBias.z += b * (gyro.z - gyroBias.z);
+    }
+
+    return still;
+}
+
+size_t StationaryDetector::label(
+    const VectorArray& gyro,
+    const VectorArray& accel,
+    bool* labels) {
+    // a local copy does not alias the labels, it stays in registers
+    StationaryDetector d { *this };
+    const size_t n { gyro.length };
+    size_t count {};
+
+    for (size_t i {}; i < n; i++) {
+        const bool s {
+            d.update(
+                Vector { gyro.x[i], gyro.y[i], gyro.z[i] },
+                Vector { accel.x[i], accel.y[i], accel.z[i] })
+        };
+        labels[i] = s;
+        count += s;
+    }
+
+    *this = d;
+
+    return count;
+}
+
+bool StationaryDetector::isStationary() const {
+    return still;
+}
+
+Vector StationaryDetector::bias() const {
+    return gyroBias;
+}
+
+size_t StationaryDetector::biasSamples() const {
+    return biasCount;
+}
+
+Vector StationaryDetector::gyroMean() const {
+    return gyroMu;
+}
+
+Vector StationaryDetector::gyroVariance() const {
+    return gyroVar;
+}
+
+Vector StationaryDetector::accelVariance() const {
+    return accelVar;
+}
+
+StationaryDetector::State StationaryDetector::checkpoint() const {
+    State state;
+    cst::store(gyroMu, state.gyroMu);
+    cst::store(gyroVar, state.gyroVar);
+    cst::store(accelMu, state.accelMu);
+    cst::store(accelVar, state.accelVar);
+    cst::store(gyroBias, state.gyroBias);
+    state.biasCount = biasCount < UINT32_MAX
+        ? static_cast<uint32_t>(biasCount)
+        : UINT32_MAX;
+    state.samples = static_cast<uint32_t>(samples);
+    state.run = static_cast<uint32_t>(run);
+    state.still = still ? 1 : 0;
+
+    return state;
+}
+
+void StationaryDetector::restore(const State& state) {
+    gyroMu = cst::loadVector(state.gyroMu);
+    gyroVar = cst::loadVector(state.gyroVar);
+    accelMu = cst::loadVector(state.accelMu);
+    accelVar = cst::loadVector(state.accelVar);
+    gyroBias = cst::loadVector(state.gyroBias);
+    biasCount = state.biasCount;
+    samples = state.samples;
+    run = state.run;
+    still = state.still != 0;
+}
@@ -0,0 +1,279 @@
+/**
+ * @file stationary.h
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Stationary state detector and gyro bias estimator.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef __LIB_CUSTOM_TYPE_STATIONARY_H__
+#define __LIB_CUSTOM_TYPE_STATIONARY_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "def.h"
+#include "vector.h"
+#include "arrays.h"
+
+/**
+ * @brief Checkpoint of a StationaryDetector (configuration excluded).
+ */
+struct StationaryState {
+    /**
+     * @brief Gyro windowed mean.
+     */
+    float gyroMu[3];
+    /**
+     * @brief Gyro windowed per-axis variance.
+     */
+    float gyroVar[3];
+    /**
+     * @brief Accel windowed mean.
+     */
+    float accelMu[3];
+    /**
+     * @brief Accel windowed per-axis variance.
+     */
+    float accelVar[3];
+    /**
+     * @brief Bias estimate.
+     */
+    float gyroBias[3];
+    /**
+     * @brief Number of samples averaged into the bias, saturated.
+     */
+    uint32_t biasCount;
+    /**
+     * @brief Number of samples seen.
+     */
+    uint32_t samples;
+    /**
+     * @brief Number of consecutive samples contradicting the state.
+     */
+    uint32_t run;
+    /**
+     * @brief Current state, 0 or 1.
+     */
+    uint8_t still;
+};
+
+/**
+ * @class StationaryDetector
+ * @brief Streaming "is the device still" detector feeding a gyro bias
+ * estimator.
+ *
+ * Gyro and accelerometer means and per-axis variances are tracked with
+ * Welford's update. The first @c window samples are averaged exactly, later
+ * samples are weighted exponentially with @f$\alpha=1/window@f$, so the cost
+ * is O(1) per sample and no sample is stored.
+ *
+ * A sample is a stationary candidate when the summed gyro and accel
+ * variances are below their thresholds and the accel norm is within a
+ * relative tolerance of gravity (checked on the squared norm). The state
+ * changes after @c enter consecutive candidates, or @c exit consecutive
+ * non-candidates (hysteresis).
+ *
+ * While stationary, the gyro bias is the mean of the candidate samples,
+ * seeded with the windowed mean at the transition. It is kept when motion
+ * resumes.
+ */
+class StationaryDetector {
+  private:
+    /**
+     * @brief Gyro windowed mean.
+     */
+    Vector gyroMu;
+    /**
+     * @brief Gyro windowed per-axis variance.
+     */
+    Vector gyroVar;
+    /**
+     * @brief Accel windowed mean.
+     */
+    Vector accelMu;
+    /**
+     * @brief Accel windowed per-axis variance.
+     */
+    Vector accelVar;
+    /**
+     * @brief Bias estimate.
+     */
+    Vector gyroBias;
+    /**
+     * @brief Number of samples averaged into #gyroBias.
+     */
+    size_t biasCount;
+    /**
+     * @brief Number of samples seen, saturates at #window.
+     */
+    size_t samples;
+    /**
+     * @brief Number of consecutive samples contradicting the state.
+     */
+    size_t run;
+    /**
+     * @brief Current state.
+     */
+    bool still;
+
+    /**
+     * @brief Window length (samples).
+     */
+    size_t window;
+    /**
+     * @brief Gyro summed variance threshold ((rad/s)^2).
+     */
+    float gyroThreshold;
+    /**
+     * @brief Accel summed variance threshold.
+     */
+    float accelThreshold;
+    /**
+     * @brief Lower bound of the squared accel norm.
+     */
+    float normLow;
+    /**
+     * @brief Upper bound of the squared accel norm.
+     */
+    float normHigh;
+    /**
+     * @brief Candidates needed to become stationary.
+     */
+    size_t enterCount;
+    /**
+     * @brief Non-candidates needed to leave the stationary state.
+     */
+    size_t exitCount;
+
+  public:
+    /**
+     * @brief Checkpoint type.
+     */
+    typedef StationaryState State;
+
+    /**
+     * @brief Construct a new StationaryDetector object.
+     *
+     * @param n Window length (samples), at least 1.
+     * @param gyroVariance Gyro summed variance threshold ((rad/s)^2).
+     * @param accelVariance Accel summed variance threshold.
+     */
+    explicit StationaryDetector(
+        size_t n = 50,
+        float gyroVariance = 1e-4f,
+        float accelVariance = 1e-2f);
+
+    /**
+     * @brief Set the variance thresholds.
+     *
+     * @param gyroVariance Gyro summed variance threshold ((rad/s)^2).
+     * @param accelVariance Accel summed variance threshold.
+     */
+    void setThresholds(float gyroVariance, float accelVariance);
+
+    /**
+     * @brief Set the accel norm check.
+     *
+     * @param tol Relative tolerance on the accel norm.
+     * @param g Accelerometer norm at rest.
+     */
+    void setAccelTolerance(float tol, float g);
+
+    /**
+     * @brief Set the hysteresis.
+     *
+     * @param enter Consecutive candidates needed to become stationary.
+     * @param exit Consecutive non-candidates needed to leave.
+     */
+    void setHysteresis(size_t enter, size_t exit);
+
+    /**
+     * @brief Clear the statistics and the state, keep the bias estimate.
+     */
+    void reset();
+
+    /**
+     * @brief Process one sample.
+     *
+     * @param gyro Angular rate (rad/s).
+     * @param accel Specific force.
+     * @return true if the device is stationary.
+     */
+    bool update(const Vector& gyro, const Vector& accel);
+
+    /**
+     * @brief Process a recorded log and label each sample. The detector
+     * state carries over, so a long log can be labelled chunk by chunk.
+     *
+     * @param gyro Angular rates (rad/s).
+     * @param accel Specific forces, same length as @p gyro.
+     * @param labels Output, one flag per sample (true when stationary).
+     * @return Number of stationary samples.
+     */
+    size_t label(
+        const VectorArray& gyro,
+        const VectorArray& accel,
+        bool* labels);
+
+    /**
+     * @brief Current state.
+     *
+     * @return true if the device is stationary.
+     */
+    bool isStationary() const;
+
+    /**
+     * @brief Gyro bias estimate.
+     *
+     * @return Vector
+     */
+    Vector bias() const;
+
+    /**
+     * @brief Number of samples averaged into the bias estimate.
+     *
+     * @return 0 if the device was never found stationary.
+     */
+    size_t biasSamples() const;
+
+    /**
+     * @brief Gyro windowed mean.
+     *
+     * @return Vector
+     */
+    Vector gyroMean() const;
+
+    /**
+     * @brief Gyro windowed per-axis variance.
+     *
+     * @return Vector
+     */
+    Vector gyroVariance() const;
+
+    /**
+     * @brief Accel windowed per-axis variance.
+     *
+     * @return Vector
+     */
+    Vector accelVariance() const;
+
+    /**
+     * @brief Snapshot of the filter state.
+     *
+     * @return State
+     */
+    State checkpoint() const;
+
+    /**
+     * @brief Resume from a snapshot; the configuration is kept.
+     *
+     * @param state State.
+     */
+    void restore(const State& state);
+};
+
+#endif /* __LIB_CUSTOM_TYPE_STATIONARY_H__ */
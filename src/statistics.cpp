@@ -0,0 +1,220 @@
+/**
+ * @file statistics.cpp
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Streaming statistics of Vector streams.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "statistics.h"
+
+VectorStatistics::VectorStatistics() : count { 0 }, mu {}, lo {}, hi {} {
+    reset();
+}
+
+void VectorStatistics::reset() {
+    count = 0;
+    mu = Vector {};
+    for (size_t i {}; i < 6; i++) {
+        m2[i] = 0.0f;
+    }
+    lo = Vector { INFINITY, INFINITY, INFINITY };
+    hi = Vector { -INFINITY, -INFINITY, -INFINITY };
+}
+
+void VectorStatistics::add(const Vector& v) {
+    count++;
+    const float inv { 1.0f / static_cast<float>(count) };
+    const float dx { v.x - mu.x };
+    const float dy { v.y - mu.y };
+    const float dz { v.z - mu.z };
+    mu.x += dx * inv;
+    mu.y += dy * inv;
+    mu.z += dz * inv;
+
+    // d (v - mean_n)^T, symmetric since v - mean_n = d (n - 1) / n
+    const float ex { v.x - mu.x };
+    const float ey { v.y - mu.y };
+    const float ez { v.z - mu.z };
+    m2[0] += dx * ex;
+    m2[1] += dy * ey;
+    m2[2] += dz * ez;
+    m2[3] += dx * ey;
+    m2[4] += dx * ez;
+    m2[5] += dy * ez;
+
+    lo = Vector { fminf(lo.x, v.x), fminf(lo.y, v.y), fminf(lo.z, v.z) };
+    hi = Vector { fmaxf(hi.x, v.x), fmaxf(hi.y, v.y), fmaxf(hi.z, v.z) };
+}
+
+void VectorStatistics::add(const VectorArray& vs) {
+    const size_t n { vs.length };
+
+    for (size_t start {}; start < n; start += STATS_BLOCK) {
+        const size_t len { n - start < STATS_BLOCK ? n - start : STATS_BLOCK };
+        const float* CST_RESTRICT xs { vs.x + start };
+        const float* CST_RESTRICT ys { vs.y + start };
+        const float* CST_RESTRICT zs { vs.z + start };
+        float dx[STATS_BLOCK];
+        float dy[STATS_BLOCK];
+        float dz[STATS_BLOCK];
+        float s[STATS_BLOCK];
+
+        // block mean, the padding is 0
+        for (size_t k {}; k < STATS_BLOCK; k++) {
+            dx[k] = k < len ? xs[k] : 0.0f;
+            dy[k] = k < len ? ys[k] : 0.0f;
+            dz[k] = k < len ? zs[k] : 0.0f;
+        }
+        const float inv { 1.0f / static_cast<float>(len) };
+        for (size_t k {}; k < STATS_BLOCK; k++) {
+            s[k] = dx[k];
+        }
+        const float mx { cst::pairwiseSum(s, STATS_BLOCK) * inv };
+        for (size_t k {}; k < STATS_BLOCK; k++) {
+            s[k] = dy[k];
+        }
+        const float my { cst::pairwiseSum(s, STATS_BLOCK) * inv };
+        for (size_t k {}; k < STATS_BLOCK; k++) {
+            s[k] = dz[k];
+        }
+        const float mz { cst::pairwiseSum(s, STATS_BLOCK) * inv };
+
+        // deviations, the padding stays 0
+        for (size_t k {}; k < STATS_BLOCK; k++) {
+            dx[k] = k < len ? dx[k] - mx : 0.0f;
+            dy[k] = k < len ? dy[k] - my : 0.0f;
+            dz[k] = k < len ? dz[k] - mz : 0.0f;
+        }
+
+        VectorStatistics block;
+        const float* const a[6] { dx, dy, dz, dx, dx, dy };
+        const float* const b[6] { dx, dy, dz, dy, dz, dz };
+        for (size_t j {}; j < 6; j++) {
+            for (size_t k {}; k < STATS_BLOCK; k++) {
+                s[k] = a[j][k] * b[j][k];
+            }
+            block.m2[j] = cst::pairwiseSum(s, STATS_BLOCK);
+        }
+
+        float lx { xs[0] };
+        float ly { ys[0] };
+        float lz { zs[0] };
+        float hx { xs[0] };
+        float hy { ys[0] };
+        float hz { zs[0] };
+        for (size_t k { 1 }; k < len; k++) {
+            lx = xs[k] < lx ? xs[k] : lx;
+            ly = ys[k] < ly ? ys[k] : ly;
+            lz = zs[k] < lz ? zs[k] : lz;
+            hx = xs[k] > hx ? xs[k] : hx;
+            hy = ys[k] > hy ? ys[k] : hy;
+            hz = zs[k] > hz ? zs[k] : hz;
+        }
+
+        block.count = len;
+        block.mu = Vector { mx, my, mz };
+        block.lo = Vector { lx, ly, lz };
+        block.hi = Vector { hx, hy, hz };
+        merge(block);
+    }
+}
+
+void VectorStatistics::merge(const VectorStatistics& other) {
+    if (other.count == 0) {
+        return;
+    }
+    if (count == 0) {
+        *this = other;
+        return;
+    }
+
+    const float na { static_cast<float>(count) };
+    const float nb { static_cast<float>(other.count) };
+    const float fb { nb / (na + nb) };
+    const float f { na * fb };
+    const float dx { other.mu.x - mu.x };
+    const float dy { other.mu.y - mu.y };
+    const float dz { other.mu.z - mu.z };
+
+    m2[0] += other.m2[0] + f * dx * dx;
+    m2[1] += other.m2[1] + f * dy * dy;
+    m2[2] += other.m2[2] + f * dz * dz;
+    m2[3] += other.m2[3] + f * dx * dy;
+    m2[4] += other.m2[4] + f * dx * dz;
+    m2[5] += other.m2[5] + f * dy * dz;
+
+    mu.x += dx * fb;
+    mu.y += dy * fb;
+    mu.z += dz * fb;
+    count += other.count;
+
+    lo = Vector {
+        fminf(lo.x, other.lo.x),
+        fminf(lo.y, other.lo.y),
+        fminf(lo.z, other.lo.z),
+    };
+    hi = Vector {
+        fmaxf(hi.x, other.hi.x),
+        fmaxf(hi.y, other.hi.y),
+        fmaxf(hi.z, other.hi.z),
+    };
+}
+
+size_t VectorStatistics::samples() const {
+    return count;
+}
+
+Vector VectorStatistics::mean() const {
+    return mu;
+}
+
+Matrix3x3 VectorStatistics::covariance() const {
+    if (count < 2) {
+        return Matrix3x3 {};
+    }
+
+    const float inv { 1.0f / static_cast<float>(count - 1) };
+
+    return Matrix3x3 {
+        m2[0] * inv, m2[3] * inv, m2[4] * inv,
+        m2[3] * inv, m2[1] * inv, m2[5] * inv,
+        m2[4] * inv, m2[5] * inv, m2[2] * inv,
+    };
+}
+
+Vector VectorStatistics::variance() const {
+    if (count < 2) {
+        return Vector {};
+    }
+
+    const float inv { 1.0f / static_cast<float>(count - 1) };
+
+    return Vector { m2[0] * inv, m2[1] * inv, m2[2] * inv };
+}
+
+Vector VectorStatistics::min() const {
+    return lo;
+}
+
+Vector VectorStatistics::max() const {
+    return hi;
+}
+
+Vector VectorStatistics::rms() const {
+    if (count == 0) {
+        return Vector {};
+    }
+
+    const float inv { 1.0f / static_cast<float>(count) };
+
+    return Vector {
+        sqrtf(cst::sqr(mu.x) + m2[0] * inv),
+        sqrtf(cst::sqr(mu.y) + m2[1] * inv),
+        sqrtf(cst::sqr(mu.z) + m2[2] * inv),
+    };
+}
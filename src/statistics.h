@@ -0,0 +1,143 @@
+/**
+ * @file statistics.h
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Streaming statistics of Vector streams.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef __LIB_CUSTOM_TYPE_STATISTICS_H__
+#define __LIB_CUSTOM_TYPE_STATISTICS_H__
+
+#include <stddef.h>
+#include "def.h"
+#include "vector.h"
+#include "matrix.h"
+#include "arrays.h"
+
+/**
+ * @brief Samples per block in the batch update (power of 2).
+ */
+const size_t STATS_BLOCK { 32 };
+
+/**
+ * @class VectorStatistics
+ * @brief Single-pass mean, covariance, min/max and RMS of a Vector stream.
+ *
+ * The mean and the co-moments about it are updated with Welford's
+ * algorithm, which does not lose precision the way raw sums of squares do.
+ * Partial states merge exactly (Chan et al.), so chunks of a log can be
+ * reduced independently and combined with #merge.
+ */
+class VectorStatistics {
+  private:
+    /**
+     * @brief Number of samples.
+     */
+    size_t count;
+    /**
+     * @brief Mean.
+     */
+    Vector mu;
+    /**
+     * @brief Co-moments about the mean: xx, yy, zz, xy, xz, yz.
+     */
+    float m2[6];
+    /**
+     * @brief Component-wise minimum.
+     */
+    Vector lo;
+    /**
+     * @brief Component-wise maximum.
+     */
+    Vector hi;
+
+  public:
+    /**
+     * @brief Construct an empty VectorStatistics object.
+     */
+    VectorStatistics();
+
+    /**
+     * @brief Forget all samples.
+     */
+    void reset();
+
+    /**
+     * @brief Add one sample.
+     *
+     * @param v Sample.
+     */
+    void add(const Vector& v);
+
+    /**
+     * @brief Add samples. Each block of #STATS_BLOCK samples is reduced
+     * with vectorisable two-pass sums, then merged.
+     *
+     * @param vs Samples.
+     */
+    void add(const VectorArray& vs);
+
+    /**
+     * @brief Combine with the statistics of another part of the stream.
+     *
+     * @param other Partial statistics.
+     */
+    void merge(const VectorStatistics& other);
+
+    /**
+     * @brief Number of samples.
+     *
+     * @return size_t
+     */
+    size_t samples() const;
+
+    /**
+     * @brief Mean.
+     *
+     * @return Vector
+     */
+    Vector mean() const;
+
+    /**
+     * @brief Sample covariance (divided by n - 1).
+     *
+     * @return Zero matrix for fewer than 2 samples.
+     */
+    Matrix3x3 covariance() const;
+
+    /**
+     * @brief Sample variance of each axis.
+     *
+     * @return Vector
+     */
+    Vector variance() const;
+
+    /**
+     * @brief Component-wise minimum.
+     *
+     * @return Vector
+     */
+    Vector min() const;
+
+    /**
+     * @brief Component-wise maximum.
+     *
+     * @return Vector
+     */
+    Vector max() const;
+
+    /**
+     * @brief Root mean square of each axis, from the mean and the
+     * population variance.
+     *
+     * @return Vector
+     */
+    Vector rms() const;
+};
+
+#endif /* __LIB_CUSTOM_TYPE_STATISTICS_H__ */
@@ -0,0 +1,254 @@
+/**
+ * @file strapdown.cpp
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Strapdown inertial navigation mechanisation.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "strapdown.h"
+#include "checkpoint.h"
+
+Strapdown::Strapdown() :
+    attitude {},
+    vel {},
+    pos {},
+    grav { 0.0f, 0.0f, 9.80665f },
+    alpha {},
+    nu {},
+    coning {},
+    sculling {},
+    prevAngle {},
+    prevVelocity {},
+    elapsed { 0.0f } {}
+
+float Strapdown::normalGravity(float latitude, float height) {
+    const float s2 { cst::sqr(sinf(latitude)) };
+
+    return 9.7803253359f * (1.0f + 0.00193185265241f * s2)
+        / sqrtf(1.0f - 0.00669437999013f * s2)
+        - 3.086e-6f * height;
+}
+
+void Strapdown::step(const Vector& phi, const Vector& dv, float dt) {
+    const Vector previous { vel };
+
+    vel += attitude.rotate(dv) + grav * dt;
+    pos += (previous + vel) * (0.5f * dt);
+
+    attitude *= Quaternion::fromRotationVector(phi);
+    // first order renormalisation, no square root
+    attitude *= 1.5f - 0.5f * attitude.normSqr();
+}
+
+void Strapdown::reset(const Quaternion& q, const Vector& v, const Vector& p) {
+    attitude = q;
+    vel = v;
+    pos = p;
+    alpha.clear();
+    nu.clear();
+    coning.clear();
+    sculling.clear();
+    prevAngle.clear();
+    prevVelocity.clear();
+    elapsed = 0.0f;
+}
+
+void Strapdown::setGravity(const Vector& g) {
+    grav = g;
+}
+
+void Strapdown::update(const Vector& gyro, const Vector& accel, float dt) {
+    const Vector phi { gyro * dt };
+    const Vector f { accel * dt };
+
+    // rotation compensation of the velocity increment
+    step(phi, f + 0.5f * phi.cross(f), dt);
+}
+
+void Strapdown::accumulate(const Vector& dTheta, const Vector& dV, float dt) {
+    // recursive coning/sculling (two-sample form with previous increment)
+    const Vector a { alpha + prevAngle * (1.0f / 6.0f) };
+    const Vector b { nu + prevVelocity * (1.0f / 6.0f) };
+
+    coning += 0.5f * a.cross(dTheta);
+    sculling += 0.5f * (a.cross(dV) + b.cross(dTheta));
+
+    alpha += dTheta;
+    nu += dV;
+    prevAngle = dTheta;
+    prevVelocity = dV;
+    elapsed += dt;
+}
+
+void Strapdown::integrate() {
+    if (elapsed <= 0.0f) {
+        return;
+    }
+
+    step(alpha + coning, nu + 0.5f * alpha.cross(nu) + sculling, elapsed);
+
+    alpha.clear();
+    nu.clear();
+    coning.clear();
+    sculling.clear();
+    elapsed = 0.0f;
+}
+
+void Strapdown::replay(
+    const VectorArray& gyro,
+    const VectorArray& accel,
+    float dt,
+    QuaternionArray& attitudes,
+    VectorArray& velocities,
+    VectorArray& positions) {
+    const float* CST_RESTRICT gx { gyro.x };
+    const float* CST_RESTRICT gy { gyro.y };
+    const float* CST_RESTRICT gz { gyro.z };
+    const float* CST_RESTRICT ax { accel.x };
+    const float* CST_RESTRICT ay { accel.y };
+    const float* CST_RESTRICT az { accel.z };
+    const bool withAttitudes { !attitudes.empty() };
+    const bool withVelocities { !velocities.empty() };
+    const bool withPositions { !positions.empty() };
+
+    float qw { attitude.w };
+    float qx { attitude.x };
+    float qy { attitude.y };
+    float qz { attitude.z };
+    float vx { vel.x };
+    float vy { vel.y };
+    float vz { vel.z };
+    float px { pos.x };
+    float py { pos.y };
+    float pz { pos.z };
+    const float gdx { grav.x * dt };
+    const float gdy { grav.y * dt };
+    const float gdz { grav.z * dt };
+    const float halfDt { 0.5f * dt };
+    const size_t n { gyro.length };
+
+    for (size_t i {}; i < n; i++) {
+        const float rx { gx[i] * dt };
+        const float ry { gy[i] * dt };
+        const float rz { gz[i] * dt };
+        const float fx { ax[i] * dt };
+        const float fy { ay[i] * dt };
+        const float fz { az[i] * dt };
+
+        // rotation compensated velocity increment, body frame
+        const float dx { fx + 0.5f * (ry * fz - rz * fy) };
+        const float dy { fy + 0.5f * (rz * fx - rx * fz) };
+        const float dz { fz + 0.5f * (rx * fy - ry * fx) };
+
+        // to the navigation frame: t = 2 (u x d), d' = d + w t + u x t
+        const float tx { 2.0f * (qy * dz - qz * dy) };
+        const float ty { 2.0f * (qz * dx - qx * dz) };
+        const float tz { 2.0f * (qx * dy - qy * dx) };
+        const float ox { vx };
+        const float oy { vy };
+        const float oz { vz };
+        vx += dx + qw * tx + (qy * tz - qz * ty) + gdx;
+        vy += dy + qw * ty + (qz * tx - qx * tz) + gdy;
+        vz += dz + qw * tz + (qx * ty - qy * tx) + gdz;
+        px += (ox + vx) * halfDt;
+        py += (oy + vy) * halfDt;
+        pz += (oz + vz) * halfDt;
+
+        // q = q * exp(phi / 2)
+        const float hx { 0.5f * rx };
+        const float hy { 0.5f * ry };
+        const float hz { 0.5f * rz };
+        const float n2 { hx * hx + hy * hy + hz * hz };
+        float c { 1.0f - n2 * (0.5f - n2 * (1.0f / 24.0f)) };
+        float s { 1.0f - n2 * ((1.0f / 6.0f) - n2 * (1.0f / 120.0f)) };
+        if (n2 >= 1e-2f) {
+            // beyond the series range, same as fromRotationVector
+            const float a { sqrtf(n2) };
+            c = cosf(a);
+            s = sinf(a) / a;
+        }
+        const float ex { s * hx };
+        const float ey { s * hy };
+        const float ez { s * hz };
+        const float nw { qw * c - qx * ex - qy * ey - qz * ez };
+        const float nx { qw * ex + qx * c + qy * ez - qz * ey };
+        const float ny { qw * ey - qx * ez + qy * c + qz * ex };
+        const float nz { qw * ez + qx * ey - qy * ex + qz * c };
+        const float k { 1.5f - 0.5f * (nw * nw + nx * nx + ny * ny + nz * nz) };
+        qw = nw * k;
+        qx = nx * k;
+        qy = ny * k;
+        qz = nz * k;
+
+        if (withAttitudes) {
+            attitudes.w[i] = qw;
+            attitudes.x[i] = qx;
+            attitudes.y[i] = qy;
+            attitudes.z[i] = qz;
+        }
+        if (withVelocities) {
+            velocities.x[i] = vx;
+            velocities.y[i] = vy;
+            velocities.z[i] = vz;
+        }
+        if (withPositions) {
+            positions.x[i] = px;
+            positions.y[i] = py;
+            positions.z[i] = pz;
+        }
+    }
+
+    attitude = Quaternion { qw, qx, qy, qz };
+    vel = Vector { vx, vy, vz };
+    pos = Vector { px, py, pz };
+}
+
+Quaternion Strapdown::orientation() const {
+    return attitude;
+}
+
+Vector Strapdown::velocity() const {
+    return vel;
+}
+
+Vector Strapdown::position() const {
+    return pos;
+}
+
+Vector Strapdown::gravity() const {
+    return grav;
+}
+
+Strapdown::State Strapdown::checkpoint() const {
+    State state;
+    cst::store(attitude, state.attitude);
+    cst::store(vel, state.vel);
+    cst::store(pos, state.pos);
+    cst::store(alpha, state.alpha);
+    cst::store(nu, state.nu);
+    cst::store(coning, state.coning);
+    cst::store(sculling, state.sculling);
+    cst::store(prevAngle, state.prevAngle);
+    cst::store(prevVelocity, state.prevVelocity);
+    state.elapsed = elapsed;
+
+    return state;
+}
+
+void Strapdown::restore(const State& state) {
+    attitude = cst::loadQuaternion(state.attitude);
+    vel = cst::loadVector(state.vel);
+    pos = cst::loadVector(state.pos);
+    alpha = cst::loadVector(state.alpha);
+    nu = cst::loadVector(state.nu);
+    coning = cst::loadVector(state.coning);
+    sculling = cst::loadVector(state.sculling);
+    prevAngle = cst::loadVector(state.prevAngle);
+    prevVelocity = cst::loadVector(state.prevVelocity);
+    elapsed = state.elapsed;
+}
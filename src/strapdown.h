@@ -0,0 +1,271 @@
+/**
+ * @file strapdown.h
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Strapdown inertial navigation mechanisation.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef __LIB_CUSTOM_TYPE_STRAPDOWN_H__
+#define __LIB_CUSTOM_TYPE_STRAPDOWN_H__
+
+#include <stddef.h>
+#include "def.h"
+#include "vector.h"
+#include "quaternion.h"
+#include "arrays.h"
+
+/**
+ * @brief Checkpoint of a Strapdown (configuration excluded).
+ */
+struct StrapdownState {
+    /**
+     * @brief Body to navigation frame rotation (w, x, y, z).
+     */
+    float attitude[4];
+    /**
+     * @brief Velocity in the navigation frame.
+     */
+    float vel[3];
+    /**
+     * @brief Position in the navigation frame.
+     */
+    float pos[3];
+    /**
+     * @brief Pending delta angle.
+     */
+    float alpha[3];
+    /**
+     * @brief Pending delta velocity.
+     */
+    float nu[3];
+    /**
+     * @brief Coning correction.
+     */
+    float coning[3];
+    /**
+     * @brief Sculling correction.
+     */
+    float sculling[3];
+    /**
+     * @brief Previous minor delta angle.
+     */
+    float prevAngle[3];
+    /**
+     * @brief Previous minor delta velocity.
+     */
+    float prevVelocity[3];
+    /**
+     * @brief Time accumulated since the last integration.
+     */
+    float elapsed;
+};
+
+/**
+ * @class Strapdown
+ * @brief Attitude, velocity and position integration in a local-level
+ * navigation frame (flat earth).
+ *
+ * The attitude rotates body vectors into the navigation frame. Gravity is a
+ * navigation-frame vector, e.g. @f$(0,0,g)@f$ in NED or @f$(0,0,-g)@f$ in
+ * ENU, see #normalGravity.
+ *
+ * Two modes are provided:
+ * - fixed step, #update: one full update per gyro/accel sample.
+ * - multi-rate, #accumulate / #integrate: delta-angle and delta-velocity
+ *   increments are summed at the IMU rate with coning and sculling
+ *   compensation, the navigation state is updated at a lower rate.
+ */
+class Strapdown {
+  private:
+    /**
+     * @brief Body to navigation frame rotation.
+     */
+    Quaternion attitude;
+    /**
+     * @brief Velocity in the navigation frame.
+     */
+    Vector vel;
+    /**
+     * @brief Position in the navigation frame.
+     */
+    Vector pos;
+    /**
+     * @brief Gravity in the navigation frame.
+     */
+    Vector grav;
+
+    /**
+     * @brief Delta angle accumulated since the last #integrate.
+     */
+    Vector alpha;
+    /**
+     * @brief Delta velocity accumulated since the last #integrate.
+     */
+    Vector nu;
+    /**
+     * @brief Coning correction.
+     */
+    Vector coning;
+    /**
+     * @brief Sculling correction.
+     */
+    Vector sculling;
+    /**
+     * @brief Previous minor delta angle.
+     */
+    Vector prevAngle;
+    /**
+     * @brief Previous minor delta velocity.
+     */
+    Vector prevVelocity;
+    /**
+     * @brief Time accumulated since the last #integrate.
+     */
+    float elapsed;
+
+    /**
+     * @brief Apply a body-frame rotation vector and specific force increment
+     * over @p dt.
+     *
+     * @param phi Rotation vector (radians).
+     * @param dv Body-frame velocity increment, rotation compensated.
+     * @param dt Interval (seconds).
+     */
+    void step(const Vector& phi, const Vector& dv, float dt);
+
+  public:
+    /**
+     * @brief Checkpoint type.
+     */
+    typedef StrapdownState State;
+
+    /**
+     * @brief Construct a new Strapdown object at rest, at the origin, with
+     * NED standard gravity.
+     */
+    Strapdown();
+
+    /**
+     * @brief Normal gravity (WGS-84 Somigliana formula with free-air
+     * correction).
+     *
+     * @param latitude Geodetic latitude (radians).
+     * @param height Height above the ellipsoid (metres).
+     * @return Gravity magnitude (m/s^2).
+     */
+    static float normalGravity(float latitude, float height = 0.0f);
+
+    /**
+     * @brief Set the navigation state, pending increments are dropped.
+     *
+     * @param q Body to navigation rotation.
+     * @param v Velocity.
+     * @param p Position.
+     */
+    void reset(
+        const Quaternion& q = Quaternion {},
+        const Vector& v = Vector {},
+        const Vector& p = Vector {});
+
+    /**
+     * @brief Set the navigation-frame gravity vector.
+     *
+     * @param g Gravity.
+     */
+    void setGravity(const Vector& g);
+
+    /**
+     * @brief Fixed-step update from rate samples.
+     *
+     * @param gyro Angular rate (rad/s), body frame.
+     * @param accel Specific force (m/s^2), body frame.
+     * @param dt Sample period (seconds).
+     */
+    void update(const Vector& gyro, const Vector& accel, float dt);
+
+    /**
+     * @brief Multi-rate: add one IMU increment, with coning and sculling
+     * compensation.
+     *
+     * @param dTheta Delta angle (radians), body frame.
+     * @param dV Delta velocity (m/s), body frame.
+     * @param dt Increment period (seconds).
+     */
+    void accumulate(const Vector& dTheta, const Vector& dV, float dt);
+
+    /**
+     * @brief Multi-rate: update the navigation state with the increments
+     * accumulated since the last call.
+     */
+    void integrate();
+
+    /**
+     * @brief Fixed-step replay of a recorded log.
+     *
+     * The loop keeps the state in registers and writes one output sample
+     * per input sample. Output arrays may be empty to skip them.
+     *
+     * @param gyro Angular rates (rad/s).
+     * @param accel Specific forces (m/s^2), same length as @p gyro.
+     * @param dt Sample period (seconds).
+     * @param attitudes Attitude after each sample.
+     * @param velocities Velocity after each sample.
+     * @param positions Position after each sample.
+     */
+    void replay(
+        const VectorArray& gyro,
+        const VectorArray& accel,
+        float dt,
+        QuaternionArray& attitudes,
+        VectorArray& velocities,
+        VectorArray& positions);
+
+    /**
+     * @brief Body to navigation rotation.
+     *
+     * @return Quaternion
+     */
+    Quaternion orientation() const;
+
+    /**
+     * @brief Navigation-frame velocity.
+     *
+     * @return Vector
+     */
+    Vector velocity() const;
+
+    /**
+     * @brief Navigation-frame position.
+     *
+     * @return Vector
+     */
+    Vector position() const;
+
+    /**
+     * @brief Navigation-frame gravity.
+     *
+     * @return Vector
+     */
+    Vector gravity() const;
+
+    /**
+     * @brief Snapshot of the filter state.
+     *
+     * @return State
+     */
+    State checkpoint() const;
+
+    /**
+     * @brief Resume from a snapshot; the configuration is kept.
+     *
+     * @param state State.
+     */
+    void restore(const State& state);
+};
+
+#endif /* __LIB_CUSTOM_TYPE_STRAPDOWN_H__ */
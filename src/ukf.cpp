@@ -0,0 +1,410 @@
+/**
+ * @file ukf.cpp
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Unscented quaternion estimator (USQUE) for attitude and gyro bias.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "ukf.h"
+#include "checkpoint.h"
+
+namespace {
+/**
+ * @brief Lower Cholesky factor of a symmetric positive definite matrix.
+ *
+ * @param a Input matrix.
+ * @param l Factor, @f$a=l\,l^T@f$.
+ * @return false if @p a is not positive definite.
+ */
+bool cholesky(
+    const float a[UKF_STATES][UKF_STATES],
+    float l[UKF_STATES][UKF_STATES]) {
+    for (size_t r {}; r < UKF_STATES; r++) {
+        for (size_t c {}; c < UKF_STATES; c++) {
+            l[r][c] = 0.0f;
+        }
+    }
+
+    for (size_t j {}; j < UKF_STATES; j++) {
+        float d { a[j][j] };
+        for (size_t k {}; k < j; k++) {
+            d -= cst::sqr(l[j][k]);
+        }
+        if (d <= 0.0f) {
+            return false;
+        }
+        l[j][j] = sqrtf(d);
+
+        const float inv { 1.0f / l[j][j] };
+        for (size_t i { j + 1 }; i < UKF_STATES; i++) {
+            float s { a[i][j] };
+            for (size_t k {}; k < j; k++) {
+                s -= l[i][k] * l[j][k];
+            }
+            l[i][j] = s * inv;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Attitude kinematics of [@p first, @p first + @p len), see
+ * AttitudeUKF::propagate.
+ *
+ * The rotation terms are taken from the series for all the quaternions
+ * (vectorisable), then recomputed with @c cosf/@c sinf for the few beyond
+ * the series range, then applied and renormalised (vectorisable).
+ *
+ * @param qs Quaternions, updated in place.
+ * @param biases Gyro bias of each quaternion.
+ * @param gyro Measured angular rate (rad/s).
+ * @param dt Sample period (seconds).
+ * @param first First quaternion.
+ * @param len Number of quaternions, at most #UKF_BLOCK.
+ */
+void propagateBlock(
+    QuaternionArray& qs,
+    const VectorArray& biases,
+    const Vector& gyro,
+    float dt,
+    size_t first,
+    size_t len) {
+    float* CST_RESTRICT qw { qs.w + first };
+    float* CST_RESTRICT qx { qs.x + first };
+    float* CST_RESTRICT qy { qs.y + first };
+    float* CST_RESTRICT qz { qs.z + first };
+    const float* CST_RESTRICT bx { biases.x + first };
+    const float* CST_RESTRICT by { biases.y + first };
+    const float* CST_RESTRICT bz { biases.z + first };
+    const float gx { gyro.x };
+    const float gy { gyro.y };
+    const float gz { gyro.z };
+    const float halfDt { 0.5f * dt };
+    float n2s[UKF_BLOCK];
+    float cs[UKF_BLOCK];
+    float ss[UKF_BLOCK];
+
+    // exp((w - b) dt / 2), small angle series
+    CST_IVDEP
+    for (size_t i {}; i < len; i++) {
+        const float hx { (gx - bx[i]) * halfDt };
+        const float hy { (gy - by[i]) * halfDt };
+        const float hz { (gz - bz[i]) * halfDt };
+        const float n2 { hx * hx + hy * hy + hz * hz };
+        n2s[i] = n2;
+        cs[i] = 1.0f - n2 * (0.5f - n2 * (1.0f / 24.0f));
+        ss[i] = 1.0f - n2 * ((1.0f / 6.0f) - n2 * (1.0f / 120.0f));
+    }
+
+    // beyond the series range, same as fromRotationVector
+    for (size_t i {}; i < len; i++) {
+        if (n2s[i] >= 1e-2f) {
+            const float a { sqrtf(n2s[i]) };
+            cs[i] = cosf(a);
+            ss[i] = sinf(a) / a;
+        }
+    }
+
+    CST_IVDEP
+    for (size_t i {}; i < len; i++) {
+        const float c { cs[i] };
+        const float k { ss[i] * halfDt };
+        const float ex { k * (gx - bx[i]) };
+        const float ey { k * (gy - by[i]) };
+        const float ez { k * (gz - bz[i]) };
+        const float w { qw[i] };
+        const float x { qx[i] };
+        const float y { qy[i] };
+        const float z { qz[i] };
+        const float nw { w * c - x * ex - y * ey - z * ez };
+        const float nx { w * ex + x * c + y * ez - z * ey };
+        const float ny { w * ey - x * ez + y * c + z * ex };
+        const float nz { w * ez + x * ey - y * ex + z * c };
+        const float r { 1.5f - 0.5f * (nw * nw + nx * nx + ny * ny + nz * nz) };
+
+        qw[i] = nw * r;
+        qx[i] = nx * r;
+        qy[i] = ny * r;
+        qz[i] = nz * r;
+    }
+}
+}  // namespace
+
+AttitudeUKF::AttitudeUKF(
+    float gyroDensity,
+    float biasDensity,
+    float angleStd,
+    float biasStd,
+    float spread) :
+    attitude {},
+    gyroBias {},
+    cov {},
+    gyroNoise { cst::sqr(gyroDensity) },
+    biasNoise { cst::sqr(biasDensity) },
+    lambda { spread },
+    chi {},
+    sigmaQ {},
+    sigmaB {} {
+    reset(Quaternion {}, Vector {}, angleStd, biasStd);
+}
+
+Quaternion AttitudeUKF::fromGRP(const Vector& p) {
+    const float n2 { p.normSqr() };
+    const float w { (16.0f - n2) / (16.0f + n2) };
+    const float k { (1.0f + w) * 0.25f };
+
+    return Quaternion { w, k * p.x, k * p.y, k * p.z };
+}
+
+Vector AttitudeUKF::toGRP(const Quaternion& q) {
+    const float k { (q.w < 0.0f ? -4.0f : 4.0f) / (1.0f + fabsf(q.w)) };
+
+    return Vector { k * q.x, k * q.y, k * q.z };
+}
+
+void AttitudeUKF::propagate(
+    QuaternionArray& qs,
+    const VectorArray& biases,
+    const Vector& gyro,
+    float dt) {
+    const size_t n { qs.length };
+    size_t i {};
+
+    for (; i + UKF_BLOCK <= n; i += UKF_BLOCK) {
+        propagateBlock(qs, biases, gyro, dt, i, UKF_BLOCK);
+    }
+    propagateBlock(qs, biases, gyro, dt, i, n - i);
+}
+
+void AttitudeUKF::reset(
+    const Quaternion& q,
+    const Vector& b,
+    float angleStd,
+    float biasStd) {
+    attitude = q;
+    gyroBias = b;
+
+    for (size_t r {}; r < UKF_STATES; r++) {
+        for (size_t c {}; c < UKF_STATES; c++) {
+            cov[r][c] = 0.0f;
+        }
+    }
+    for (size_t i {}; i < 3; i++) {
+        cov[i][i] = cst::sqr(angleStd);
+        cov[i + 3][i + 3] = cst::sqr(biasStd);
+    }
+}
+
+bool AttitudeUKF::drawSigmas(float extra, float extraBias) {
+    const float scale { static_cast<float>(UKF_STATES) + lambda };
+    float a[UKF_STATES][UKF_STATES];
+    float l[UKF_STATES][UKF_STATES];
+
+    for (size_t r {}; r < UKF_STATES; r++) {
+        for (size_t c {}; c < UKF_STATES; c++) {
+            a[r][c] = cov[r][c];
+        }
+        a[r][r] += r < 3 ? extra : extraBias;
+        for (size_t c {}; c < UKF_STATES; c++) {
+            a[r][c] *= scale;
+        }
+    }
+
+    if (!cholesky(a, l)) {
+        return false;
+    }
+
+    for (size_t k {}; k < UKF_STATES; k++) {
+        chi[0][k] = 0.0f;
+    }
+    for (size_t i {}; i < UKF_STATES; i++) {
+        for (size_t k {}; k < UKF_STATES; k++) {
+            chi[1 + i][k] = l[k][i];
+            chi[1 + UKF_STATES + i][k] = -l[k][i];
+        }
+    }
+
+    for (size_t i {}; i < UKF_SIGMAS; i++) {
+        const Quaternion q {
+            attitude * fromGRP(Vector { chi[i][0], chi[i][1], chi[i][2] })
+        };
+        sigmaQ[0][i] = q.w;
+        sigmaQ[1][i] = q.x;
+        sigmaQ[2][i] = q.y;
+        sigmaQ[3][i] = q.z;
+        sigmaB[0][i] = gyroBias.x + chi[i][3];
+        sigmaB[1][i] = gyroBias.y + chi[i][4];
+        sigmaB[2][i] = gyroBias.z + chi[i][5];
+    }
+
+    return true;
+}
+
+void AttitudeUKF::recombine(float mean[UKF_STATES]) {
+    const float scale { static_cast<float>(UKF_STATES) + lambda };
+    const float w0 { lambda / scale };
+    const float wi { 0.5f / scale };
+
+    for (size_t k {}; k < UKF_STATES; k++) {
+        mean[k] = w0 * chi[0][k];
+        for (size_t i { 1 }; i < UKF_SIGMAS; i++) {
+            mean[k] += wi * chi[i][k];
+        }
+    }
+
+    for (size_t r {}; r < UKF_STATES; r++) {
+        for (size_t c { r }; c < UKF_STATES; c++) {
+            float s {};
+            for (size_t i {}; i < UKF_SIGMAS; i++) {
+                s += (i == 0 ? w0 : wi) * (chi[i][r] - mean[r])
+                    * (chi[i][c] - mean[c]);
+            }
+            cov[r][c] = s;
+            cov[c][r] = s;
+        }
+    }
+}
+
+void AttitudeUKF::inject(const float dx[UKF_STATES]) {
+    attitude *= fromGRP(Vector { dx[0], dx[1], dx[2] });
+    attitude.normalize();
+    gyroBias += Vector { dx[3], dx[4], dx[5] };
+}
+
+bool AttitudeUKF::predict(const Vector& gyro, float dt) {
+    // process noise enters through the spread of the sigma points
+    if (!drawSigmas(gyroNoise * dt, biasNoise * dt)) {
+        return false;
+    }
+
+    QuaternionArray qs {
+        sigmaQ[0], sigmaQ[1], sigmaQ[2], sigmaQ[3], UKF_SIGMAS,
+    };
+    const VectorArray bs {
+        sigmaB[0], sigmaB[1], sigmaB[2], UKF_SIGMAS,
+    };
+    propagate(qs, bs, gyro, dt);
+
+    // errors relative to the propagated central sigma point
+    const Quaternion q0 { qs.get(0) };
+    const Quaternion q0Inv { q0.conjugate() };
+    for (size_t i { 1 }; i < UKF_SIGMAS; i++) {
+        const Vector p { toGRP(q0Inv * qs.get(i)) };
+        chi[i][0] = p.x;
+        chi[i][1] = p.y;
+        chi[i][2] = p.z;
+    }
+
+    attitude = q0;
+    float mean[UKF_STATES];
+    recombine(mean);
+    inject(mean);
+
+    return true;
+}
+
+bool AttitudeUKF::correct(
+    const Vector& measured,
+    const Vector& reference,
+    float noiseStd) {
+    if (!drawSigmas(0.0f, 0.0f)) {
+        return false;
+    }
+
+    const float scale { static_cast<float>(UKF_STATES) + lambda };
+    const float w0 { lambda / scale };
+    const float wi { 0.5f / scale };
+    const Vector r { reference.normalised() };
+    const QuaternionArray qs {
+        sigmaQ[0], sigmaQ[1], sigmaQ[2], sigmaQ[3], UKF_SIGMAS,
+    };
+
+    Vector zs[UKF_SIGMAS];
+    Vector zMean;
+    for (size_t i {}; i < UKF_SIGMAS; i++) {
+        zs[i] = qs.get(i).conjugate().rotate(r);
+        zMean += zs[i] * (i == 0 ? w0 : wi);
+    }
+
+    // innovation and cross covariances (the sigma errors have zero mean)
+    Matrix3x3 pzz;
+    float pxz[UKF_STATES][3] {};
+    for (size_t i {}; i < UKF_SIGMAS; i++) {
+        const float w { i == 0 ? w0 : wi };
+        const Vector dz { zs[i] - zMean };
+        pzz += Matrix3x3::merge(dz * dz.x, dz * dz.y, dz * dz.z) * w;
+        for (size_t k {}; k < UKF_STATES; k++) {
+            pxz[k][0] += w * chi[i][k] * dz.x;
+            pxz[k][1] += w * chi[i][k] * dz.y;
+            pxz[k][2] += w * chi[i][k] * dz.z;
+        }
+    }
+    for (size_t i {}; i < 3; i++) {
+        pzz.set(i, pzz.coeff(i, i) + cst::sqr(noiseStd));
+    }
+
+    const Matrix3x3 pzzInv { pzz.inverse() };
+    const Vector y { measured.normalised() - zMean };
+    float gain[UKF_STATES][3];
+    float dx[UKF_STATES];
+
+    for (size_t k {}; k < UKF_STATES; k++) {
+        const Vector row { pxz[k][0], pxz[k][1], pxz[k][2] };
+        // K = Pxz Pzz^-1, Pzz^-1 is symmetric
+        gain[k][0] = row.dot(pzzInv.col(0));
+        gain[k][1] = row.dot(pzzInv.col(1));
+        gain[k][2] = row.dot(pzzInv.col(2));
+        dx[k] = gain[k][0] * y.x + gain[k][1] * y.y + gain[k][2] * y.z;
+    }
+
+    // P -= K Pzz K^T = K Pxz^T
+    for (size_t r0 {}; r0 < UKF_STATES; r0++) {
+        for (size_t c { r0 }; c < UKF_STATES; c++) {
+            const float s {
+                gain[r0][0] * pxz[c][0] + gain[r0][1] * pxz[c][1]
+                + gain[r0][2] * pxz[c][2]
+            };
+            cov[r0][c] -= s;
+            if (c != r0) {
+                cov[c][r0] -= s;
+            }
+        }
+    }
+
+    inject(dx);
+
+    return true;
+}
+
+Quaternion AttitudeUKF::orientation() const {
+    return attitude;
+}
+
+Vector AttitudeUKF::bias() const {
+    return gyroBias;
+}
+
+float AttitudeUKF::covariance(size_t r, size_t c) const {
+    return cov[r][c];
+}
+
+AttitudeUKF::State AttitudeUKF::checkpoint() const {
+    State state;
+    cst::store(attitude, state.attitude);
+    cst::store(gyroBias, state.gyroBias);
+    memcpy(state.cov, cov, sizeof(cov));
+
+    return state;
+}
+
+void AttitudeUKF::restore(const State& state) {
+    attitude = cst::loadQuaternion(state.attitude);
+    gyroBias = cst::loadVector(state.gyroBias);
+    memcpy(cov, state.cov, sizeof(cov));
+}
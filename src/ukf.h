@@ -0,0 +1,267 @@
+/**
+ * @file ukf.h
+ * @date 17.10.26
+ * @author amad3v (amad3v@gmail.com)
+ * @version 0.0.1
+ *
+ * @brief Unscented quaternion estimator (USQUE) for attitude and gyro bias.
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef __LIB_CUSTOM_TYPE_UKF_H__
+#define __LIB_CUSTOM_TYPE_UKF_H__
+
+#include <stddef.h>
+#include "def.h"
+#include "vector.h"
+#include "quaternion.h"
+#include "matrix.h"
+#include "arrays.h"
+
+/**
+ * @brief Error-state dimension: attitude error (GRP) and gyro bias.
+ */
+const size_t UKF_STATES { 6 };
+
+/**
+ * @brief Number of sigma points, @f$2n+1@f$.
+ */
+const size_t UKF_SIGMAS { 2 * UKF_STATES + 1 };
+
+/**
+ * @brief Quaternions per block in AttitudeUKF::propagate (covers the sigma
+ * points in one block).
+ */
+const size_t UKF_BLOCK { 16 };
+
+/**
+ * @brief Checkpoint of an AttitudeUKF (configuration excluded).
+ */
+struct UkfState {
+    /**
+     * @brief Mean body to navigation rotation (w, x, y, z).
+     */
+    float attitude[4];
+    /**
+     * @brief Mean gyro bias.
+     */
+    float gyroBias[3];
+    /**
+     * @brief Error covariance, row-major.
+     */
+    float cov[UKF_STATES][UKF_STATES];
+};
+
+/**
+ * @class AttitudeUKF
+ * @brief Unscented quaternion estimator (USQUE, Crassidis & Markley).
+ *
+ * The attitude error is parametrised with generalised Rodrigues parameters
+ * (@f$a=1,f=4@f$, which match the rotation vector to first order) around
+ * the mean quaternion. Sigma points are kept as SoA arrays so that their
+ * propagation through the attitude kinematics is one batch loop
+ * (#propagate).
+ */
+class AttitudeUKF {
+  private:
+    /**
+     * @brief Mean body to navigation rotation.
+     */
+    Quaternion attitude;
+    /**
+     * @brief Mean gyro bias.
+     */
+    Vector gyroBias;
+    /**
+     * @brief Error covariance, row-major.
+     */
+    float cov[UKF_STATES][UKF_STATES];
+    /**
+     * @brief Gyro white noise density, squared.
+     */
+    float gyroNoise;
+    /**
+     * @brief Bias random walk density, squared.
+     */
+    float biasNoise;
+    /**
+     * @brief Spread parameter @f$\lambda@f$.
+     */
+    float lambda;
+
+    /**
+     * @brief Sigma point errors, one row per sigma point.
+     */
+    float chi[UKF_SIGMAS][UKF_STATES];
+    /**
+     * @brief Sigma quaternions storage (w, x, y, z).
+     */
+    float sigmaQ[4][UKF_SIGMAS];
+    /**
+     * @brief Sigma biases storage (x, y, z).
+     */
+    float sigmaB[3][UKF_SIGMAS];
+
+    /**
+     * @brief Draw sigma points around the mean into #chi, #sigmaQ and
+     * #sigmaB.
+     *
+     * @param extra Variance added to the attitude and bias diagonals before
+     * the factorisation (process noise), may be 0.
+     * @param extraBias Bias part of @p extra.
+     * @return false if the covariance is not positive definite.
+     */
+    bool drawSigmas(float extra, float extraBias);
+
+    /**
+     * @brief Weighted mean of #chi, and the covariance around it into
+     * #cov. The process noise is not added here but before the sigma
+     * points are drawn, see #drawSigmas.
+     *
+     * @param mean Weighted mean of the errors.
+     */
+    void recombine(float mean[UKF_STATES]);
+
+    /**
+     * @brief Move the attitude part of the mean error into the quaternion.
+     *
+     * @param dx Error state, attitude then bias.
+     */
+    void inject(const float dx[UKF_STATES]);
+
+  public:
+    /**
+     * @brief Checkpoint type.
+     */
+    typedef UkfState State;
+
+    /**
+     * @brief Construct a new AttitudeUKF object.
+     *
+     * @param gyroDensity Gyro white noise density (rad/s/sqrt(Hz)).
+     * @param biasDensity Bias random walk density (rad/s^2/sqrt(Hz)).
+     * @param angleStd Initial attitude standard deviation (rad).
+     * @param biasStd Initial bias standard deviation (rad/s).
+     * @param spread Sigma point spread @f$\lambda@f$.
+     */
+    explicit AttitudeUKF(
+        float gyroDensity = 1e-3f,
+        float biasDensity = 1e-5f,
+        float angleStd = 0.1f,
+        float biasStd = 0.01f,
+        float spread = 1.0f);
+
+    /**
+     * @brief Quaternion from generalised Rodrigues parameters (a=1, f=4).
+     *
+     * @param p GRP vector.
+     * @return Unit quaternion.
+     */
+    static Quaternion fromGRP(const Vector& p);
+
+    /**
+     * @brief Generalised Rodrigues parameters (a=1, f=4) of a unit
+     * quaternion, taken in the @f$w\geq0@f$ hemisphere.
+     *
+     * @param q Unit quaternion.
+     * @return GRP vector.
+     */
+    static Vector toGRP(const Quaternion& q);
+
+    /**
+     * @brief Batch attitude kinematics:
+     * @f$q_i\leftarrow q_i\otimes\exp\left((\omega-b_i)\Delta t/2\right)@f$.
+     *
+     * The exponential is a series for small angles and @c cosf/@c sinf
+     * beyond (as Quaternion::fromRotationVector); the results are
+     * renormalised to first order.
+     *
+     * @param qs Quaternions, updated in place.
+     * @param biases Gyro bias of each quaternion.
+     * @param gyro Measured angular rate (rad/s).
+     * @param dt Sample period (seconds).
+     */
+    static void propagate(
+        QuaternionArray& qs,
+        const VectorArray& biases,
+        const Vector& gyro,
+        float dt);
+
+    /**
+     * @brief Set the state and reset the covariance.
+     *
+     * @param q Body to navigation rotation.
+     * @param b Gyro bias.
+     * @param angleStd Attitude standard deviation (rad).
+     * @param biasStd Bias standard deviation (rad/s).
+     */
+    void reset(
+        const Quaternion& q,
+        const Vector& b,
+        float angleStd,
+        float biasStd);
+
+    /**
+     * @brief Propagate the sigma points with a gyro sample.
+     *
+     * @param gyro Angular rate (rad/s), body frame.
+     * @param dt Sample period (seconds).
+     * @return false if the covariance lost positive definiteness (the
+     * state is left unchanged).
+     */
+    bool predict(const Vector& gyro, float dt);
+
+    /**
+     * @brief Update with a measured direction.
+     *
+     * @param measured Direction measured in the body frame.
+     * @param reference Same direction in the navigation frame.
+     * @param noiseStd Measurement standard deviation of the unit direction.
+     * @return false if the covariance lost positive definiteness.
+     */
+    bool correct(
+        const Vector& measured,
+        const Vector& reference,
+        float noiseStd);
+
+    /**
+     * @brief Body to navigation rotation.
+     *
+     * @return Quaternion
+     */
+    Quaternion orientation() const;
+
+    /**
+     * @brief Gyro bias estimate.
+     *
+     * @return Vector
+     */
+    Vector bias() const;
+
+    /**
+     * @brief Error covariance element.
+     *
+     * @param r Row index [0..5].
+     * @param c Column index [0..5].
+     * @return float
+     */
+    float covariance(size_t r, size_t c) const;
+
+    /**
+     * @brief Snapshot of the filter state.
+     *
+     * @return State
+     */
+    State checkpoint() const;
+
+    /**
+     * @brief Resume from a snapshot; the configuration is kept.
+     *
+     * @param state State.
+     */
+    void restore(const State& state);
+};
+
+#endif /* __LIB_CUSTOM_TYPE_UKF_H__ */
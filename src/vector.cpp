@@ -51,7 +51,7 @@ Vector Vector::cross(const Vector& rhs) const {
 }
 
 float Vector::dot(const Vector& rhs) const {
-    return x * rhs.x + y * rhs.y;
+    return x * rhs.x + y * rhs.y + z * rhs.z;
 }
 
 void Vector::setUndefined() {
@@ -49,6 +49,13 @@ class Vector {
      */
     explicit Vector(float a = 0.0f, float b = 0.0f, float c = 0.0f);
 
+    /**
+     * @brief Copy constructor.
+     *
+     * @param rhs Vector to copy from.
+     */
+    Vector(const Vector& rhs) = default;
+
     /**
      * @brief Static method to create a vector with
      * the same value.